@@ -51,6 +51,7 @@ namespace rc
     // #if defined ROBOT_MYCOBOT
     constexpr const double CoordsEpsilon = 5.0;
     constexpr const double EncodersEpsilon = 50.0;
+    constexpr const double AnglesEpsilon = 0.5;
     // #elif defined ROBOT_MYCOBOTPRO
     // constexpr const double CoordsEpsilon = 1.0;
     // constexpr const double EncodersEpsilon = 10.0;
@@ -248,5 +249,6 @@ namespace rc
     Angles ROBOSIGNALSHARED_EXPORT InvalidAngles();
 }
 Q_DECLARE_METATYPE(rc::Coords)
+Q_DECLARE_METATYPE(rc::IntAngles)
 Q_DECLARE_METATYPE(rc::PortsInfo)
 #endif
@@ -2,10 +2,14 @@
 #define ROBOSIGNAL_MYCOBOT_HPP
 
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 #include <functional>
+#include <future>
 #include <mutex>
 #include <queue>
 
@@ -13,12 +17,29 @@
 #include <QTimer>
 #include <QByteArray>
 #include <QEventLoop>
+#include <QThread>
 
 #include "robosignal_global.hpp"
 #include "Common.hpp"
 
 namespace rc
 {
+    class ChangeFilter;
+    class LatencyTracker;
+    class MotionEstimator;
+    class MotionPollingPolicy;
+    class PacketDecoder;
+    class PollRateController;
+    class PollingSchedule;
+    class RequestPipeline;
+    template <typename T>
+    class SeqLock;
+    class SerialCaptureWriter;
+    class SerialWorker;
+    class TelemetryRecorder;
+    struct TelemetryHistory;
+    struct PacketView;
+
     constexpr const int SERIAL_TIMEOUT = 1000;     // 동기 함수들의 기본 타임아웃 (ms)
     constexpr const int PRESENT_LOAD_ADDRESS = 60; // 부하 주소는 60 (0x3C)
 
@@ -30,7 +51,222 @@ namespace rc
         REQ_Speeds,
         REQ_Loads,
         REQ_IsMoving,
-        REQ_Voltages
+        REQ_Voltages,
+        REQ_LoadSweep, // J1~J6 부하를 한 번에 (scheduleRequest에서 관절별 REQ_Loads로 펼쳐집니다)
+        // 비동기 조회 (Get...Async / Is...Async). REQ_IsInPosition은 IsInPositionAsync()로만 보낼 수 있습니다.
+        REQ_Encoders,
+        REQ_Speed,
+        REQ_IsPowerOn,
+        REQ_IsProgramPaused,
+        REQ_IsInPosition,
+        REQ_IsServoEnabled,
+        REQ_IsAllServoEnabled
+    };
+
+    // 비동기 조회 결과. ok가 false이면 error에 이유(타임아웃, 전송 실패 등)가 들어갑니다.
+    template <typename T>
+    struct QueryResult
+    {
+        bool ok{false};
+        T value{};
+        std::string error{};
+    };
+
+    template <typename T>
+    using QueryCallback = std::function<void(const QueryResult<T> &)>;
+
+    // 스케줄러 요청 처리 통계 (누적)
+    struct RequestStats
+    {
+        std::size_t queued{0};    // 대기열에 있는 요청 수
+        std::size_t in_flight{0}; // 응답을 기다리는 요청 수
+        uint64_t completed{0};    // 응답을 받은 요청 수
+        uint64_t timed_out{0};    // deadline이 지난 요청 수 (= retried + dropped)
+        uint64_t retried{0};      // 타임아웃 후 다시 보낸 요청 수
+        uint64_t dropped{0};      // 재시도 횟수를 다 써서 버린 요청 수
+        uint64_t merged{0};       // 같은 요청이 이미 대기 중이어서 합친 수
+        uint64_t rejected{0};     // 대기열이 가득 차서 거부한 요청 수
+        uint64_t evicted{0};      // 더 높은 우선순위 요청에 밀려난 요청 수
+        bool saturated{false};    // 대기열이 가득 찬 상태 (backpressure)
+    };
+
+    // 수신 스트림 디코딩 통계 (누적)
+    struct StreamStats
+    {
+        uint64_t packets{0};         // 디코딩된 유효 패킷 수
+        uint64_t resyncs{0};         // 잘못된 헤더 후보(LEN/푸터 불일치)로 다시 동기화한 횟수
+        uint64_t discarded_bytes{0}; // 패킷에 속하지 않아 버린 바이트 수
+        uint64_t dropped_packets{0}; // I/O 스레드 수신 큐가 가득 차서 버린 패킷 수
+    };
+
+    // 텔레메트리 기록 상태 (StartTelemetryRecording 이후 누적)
+    struct TelemetryRecordingStats
+    {
+        bool recording{false};
+        bool failed{false};     // 쓰기 실패(디스크 부족 등)로 기록을 멈춤
+        uint64_t written{0};    // 파일에 쓴 샘플 수
+        uint64_t dropped{0};    // 기록 큐가 가득 찼거나 쓰기에 실패해 버린 샘플 수
+        uint64_t file_size{0};  // 바이트
+    };
+
+    // ReplaySerialCapture 결과
+    struct ReplayStats
+    {
+        bool ok{false};
+        std::string error{};
+        uint64_t rx_chunks{0};                 // 다시 넣은 수신 덩어리 수
+        uint64_t rx_bytes{0};
+        uint64_t tx_frames{0};                 // 캡처에 있던 송신 프레임 수 (응답 짝짓기에만 반영)
+        uint64_t packets{0};                   // 디스패치한 패킷 수
+        std::chrono::nanoseconds captured{0};  // 캡처 길이 (첫 레코드 ~ 마지막 레코드)
+        std::chrono::nanoseconds elapsed{0};   // 재생에 걸린 시간
+    };
+
+    // 명령어별 왕복 지연 (명령 전송 ~ 응답 수신, 마이크로초)
+    struct LatencyStats
+    {
+        unsigned char command{0}; // Firmata 명령어 ID
+        uint64_t count{0};
+        double p50_us{0.0};
+        double p99_us{0.0};
+        double max_us{0.0};
+        double mean_us{0.0};
+    };
+
+    // 캐시된 값 하나의 수신 정보 (steady_clock 기준)
+    struct SampleInfo
+    {
+        std::chrono::steady_clock::time_point sent_at{};     // 요청을 보낸 시각 (짝지을 요청이 없으면 received_at)
+        std::chrono::steady_clock::time_point received_at{}; // 응답을 받은 시각
+        uint64_t sequence{0};                                // 채널별 갱신 번호 (1부터, 0이면 아직 받은 적 없음)
+    };
+
+    // 캐시된 값과 그 수신 정보
+    template <typename T>
+    struct Sample : SampleInfo
+    {
+        T value{};
+
+        bool Valid() const { return sequence != 0; }
+        // 받은 뒤 지난 시간 (받은 적이 없으면 duration::max())
+        std::chrono::steady_clock::duration Age(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) const
+        {
+            return Valid() ? now - received_at : std::chrono::steady_clock::duration::max();
+        }
+    };
+
+    // 관절별 위치/속도/가속도 추정값 (PeekJointMotion: 도, 도/s, 도/s², PeekEncoderMotion: 엔코더 단위)
+    struct JointMotion
+    {
+        Angles position{};     // 필터링된 위치
+        Angles velocity{};     // 초당 변화량
+        Angles acceleration{}; // 초당 속도 변화량
+    };
+
+    // 마지막 동작 명령의 목표 (WriteAngles/WriteAngle: 관절 각도, WriteCoords/WriteCoord: 좌표)
+    struct MotionCommand
+    {
+        Angles target{};
+        unsigned mask{0}; // 목표가 있는 관절/축 비트 (J1, X = bit 0). 0이면 명령 없음
+        int speed{0};     // 명령에 준 속도 값
+        std::chrono::steady_clock::time_point sent_at{};
+    };
+
+    // PeekAnglesAt/PeekCoordsAt 추정 방법
+    enum class EstimateKind
+    {
+        NoData,       // 받은 값이 없음
+        Interpolated, // 앞뒤 측정 사이를 보간
+        Extrapolated, // 마지막 추정 운동으로 외삽 (명령 목표를 넘지 않음)
+        Held,         // 측정값을 그대로 (이력보다 이른 시각 등)
+    };
+
+    // 임의 시각의 상태 추정값
+    template <typename T>
+    struct Estimate
+    {
+        T value{};
+        EstimateKind kind{EstimateKind::NoData};
+        // 가장 가까운 측정에서 떨어진 시간이 예측 한계를 넘었거나, 마지막 측정 뒤에 새 동작 명령을 보냈거나,
+        // 값이 없으면 true
+        bool uncertain{true};
+        std::chrono::steady_clock::duration horizon{}; // 가장 가까운 측정 시각까지의 거리
+    };
+
+    // 캐시된 텔레메트리 채널 (기록 파일의 열, 변경 알림 등)
+    enum class TelemetryChannel : uint16_t
+    {
+        CH_Angles,
+        CH_Coords,
+        CH_Encoders,
+        CH_Speeds,
+        CH_Voltages,
+        CH_IsMoving,
+        CH_LoadJ1, // CH_LoadJ1 + (관절 - 1)
+        CH_LoadJ2,
+        CH_LoadJ3,
+        CH_LoadJ4,
+        CH_LoadJ5,
+        CH_LoadJ6,
+    };
+    constexpr std::size_t TelemetryChannelCount = static_cast<std::size_t>(TelemetryChannel::CH_LoadJ6) + 1;
+
+    // J1~J6 부하를 모두 받은 스윕 하나 (한 번에 갱신됩니다)
+    struct LoadSweep
+    {
+        IntAngles loads{};
+        std::chrono::steady_clock::time_point started_at{};   // 스윕 요청 시각
+        std::chrono::steady_clock::time_point completed_at{}; // 마지막 관절 응답 시각
+        uint64_t sequence{0};  // 완성된 스윕 번호 (1부터, 0이면 아직 없음)
+        uint64_t abandoned{0}; // 응답이 빠져 완성되지 못한 스윕 수 (누적)
+    };
+
+    // 캐시된 로봇 상태 전체. PeekState()는 한 번의 수신 처리가 끝난 시점의 값을 한꺼번에 돌려줍니다.
+    struct RobotState
+    {
+        Sample<Angles> angles{};
+        Sample<Coords> coords{};
+        Sample<Angles> encoders{};
+        Sample<IntAngles> speeds{};                // 관절별 실제 속도 (GET_SERVO_SPEEDS)
+        Sample<Voltages> voltages{};
+        std::array<Sample<int>, Joints> loads{};   // 관절별 마지막 부하 값
+        Sample<bool> is_moving{{}, true};          // 첫 응답 전에는 움직이는 것으로 봅니다.
+        Sample<JointMotion> joint_motion{};        // GetAngles로 추정한 관절 운동
+        Sample<JointMotion> encoder_motion{};      // GetEncoders로 추정한 관절 운동
+        Sample<JointMotion> coord_motion{};        // GetCoords로 추정한 좌표 운동
+        MotionCommand angle_command{};
+        MotionCommand coord_command{};
+        LoadSweep load_sweep{};
+        double speed{0.0};                         // GetSpeed
+        bool is_powered_on{false};
+        bool is_program_paused{false};
+        bool is_in_position{false};
+        bool is_all_servo_enabled{false};
+        std::array<bool, Joints> servo_enabled{};
+    };
+
+    // 폴링 계획 항목: 요청 종류, 관절(REQ_Loads만 사용), 요청 주파수
+    struct PollingEntry
+    {
+        RequestType type{RequestType::REQ_Angles};
+        Joint joint{J1};
+        double rate_hz{0.0};
+    };
+
+    // 자동 폴링 상태 (적응형 모드에서는 측정값으로 주기가 바뀝니다)
+    struct PollingStats
+    {
+        bool active{false};
+        bool adaptive{false};
+        int interval_ms{0};             // 현재 폴링 주기
+        double target_utilization{0.0}; // 적응형 모드의 목표 링크 사용률
+        double utilization{0.0};        // 측정한 링크 사용률 (송수신 바이트 기준)
+        double round_trip_us{0.0};      // 요청 왕복 지연 평균 (EWMA)
+        double bytes_per_poll{0.0};     // 폴링 1회당 송수신 바이트 평균 (EWMA)
+        bool over_budget{false};        // staleness budget 안에 폴링할 수 없는 상태
+        double plan_utilization{0.0};   // 폴링 계획의 예상 링크 사용률
+        bool plan_degraded{false};      // 링크 예산 때문에 계획의 주파수를 낮춘 상태
+        bool idle{false};               // 움직임 기반 폴링에서 정지 상태로 보고 틱을 늘린 상태
     };
 
     class ROBOSIGNALSHARED_EXPORT MyCobot : public QObject
@@ -41,7 +277,7 @@ namespace rc
         // --- 싱글톤 및 기본 설정 ---
         MyCobot(const MyCobot &) = delete;
         MyCobot &operator=(const MyCobot &) = delete;
-        virtual ~MyCobot() = default;
+        virtual ~MyCobot();
         static MyCobot &Instance();
 
         // --- 연결 및 초기화 ---
@@ -50,6 +286,12 @@ namespace rc
         int Disconnect();
         bool IsCncConnected();
         void SetFreshMode(int mode);
+        // 전용 I/O 스레드에서 시리얼 포트를 읽고 디코딩합니다. Connect()/Init() 전에 호출해야 합니다.
+        void SetIoThreadEnabled(bool enabled);
+        bool IsIoThreadEnabled() const;
+        // 송신 대기 중인 프레임 수와, 포트에 아직 써지지 않은(bytesWritten 미확인) 바이트 수
+        std::size_t TxQueueDepth() const;
+        qint64 TxBytesPending() const;
 
         // ======================================================================
         // API 그룹 1: 쓰기(Write) 및 직접 실행 함수 (Fire-and-Forget)
@@ -71,29 +313,110 @@ namespace rc
         // ======================================================================
         // API 그룹 2: 데이터 자동 수집 제어 (Autonomous Factory Control)
         // ======================================================================
+        // interval_ms는 폴링 기본 틱의 상한입니다. 폴링 계획이 없으면 IsMoving, Speeds, J1 부하를
+        // 한 틱에 하나씩 돌아가며 요청합니다.
         void startAutoPolling(int interval_ms = 50);
+        // 측정한 왕복 지연과 링크 사용률(m_baud_rate 기준)로 폴링 주기를 스스로 정합니다.
+        // staleness_budget_ms는 폴링 틱의 상한입니다. 틱은 링크와 지연이 허락하면 계획의 기본 틱보다 짧아질 수 있습니다.
+        void startAdaptivePolling(double target_utilization = 0.5, int staleness_budget_ms = 100);
         void stopAutoPolling();
+        PollingStats GetPollingStats() const;
+        // 폴링 계획을 고정 틱 스케줄로 컴파일합니다. 폴링 중에도 바꿀 수 있으며, 빈 계획이면 기본 계획으로 돌아갑니다.
+        // 예상 링크 사용률이 목표(startAdaptivePolling의 target_utilization, 기본 0.5)를 넘으면 낮은 우선순위부터 주파수를 낮춥니다.
+        void SetPollingPlan(const std::vector<PollingEntry> &plan);
+        // 실제 적용된 계획 (rate_hz는 틱에 맞춰 조정된 주파수)
+        std::vector<PollingEntry> GetPollingPlan() const;
+        // 로봇이 멈춰 있으면 폴링 틱을 heartbeat_ms까지 점점 늘리고, 동작 명령을 보내거나 움직임이 보고되면
+        // 바로 기본 틱으로 돌아갑니다. 정지 상태에서도 틱마다 IsMoving을 요청합니다.
+        void SetMotionAwarePolling(bool enabled, int heartbeat_ms = 1000, int settle_ms = 500);
 
         // ★★★ [최종] 모든 데이터 요청을 이 함수 하나로 통일합니다. ★★★
         // 이 함수가 바로 '관제탑에 착륙 요청을 접수하는' 역할을 합니다.
-        void scheduleRequest(RequestType request_type, Joint joint = Joint::J1);
+        // 같은 요청이 이미 대기 중이면 합쳐지고, 대기열이 가득 차서 거부되면 false를 반환합니다.
+        bool scheduleRequest(RequestType request_type, Joint joint = Joint::J1);
+        // 응답을 기다리지 않고 동시에 보낼 수 있는 요청 수와 요청별 응답 대기 시간
+        void SetRequestWindow(int window);
+        void SetRequestTimeout(int timeout_ms);
+        // 응답이 오지 않은 요청을 다시 보낼 최대 횟수 (0이면 재시도 없이 버림)
+        void SetRequestRetries(int max_retries);
+        // 대기열 최대 길이 (응답 대기 중인 요청 제외)
+        void SetRequestQueueDepth(int max_depth);
+        RequestStats GetRequestStats() const;
+        StreamStats GetStreamStats() const;
+        // 명령어별 왕복 지연 히스토그램 조회. 측정된 적이 없으면 count가 0입니다.
+        LatencyStats GetLatencyStats(unsigned char command) const;
+        std::vector<LatencyStats> GetAllLatencyStats() const;
+        void ResetLatencyStats();
+        // 수신한 샘플을 모두 메모리 매핑 파일에 기록합니다 (TelemetryFile.hpp의 TelemetryReader로 읽음).
+        // 파일 쓰기는 별도 스레드에서 하므로 수신 처리를 막지 않습니다. 파일을 만들 수 없으면 false
+        bool StartTelemetryRecording(const std::string &path);
+        void StopTelemetryRecording();
+        TelemetryRecordingStats GetTelemetryRecordingStats() const;
+        // 시리얼로 읽은 바이트 덩어리와 보낸 프레임을 시각과 함께 캡처 파일에 기록합니다. (현장 버그 재현용)
+        // I/O 스레드 모드에서는 디코딩된 패킷을 프레임으로 다시 만들어 기록합니다. 파일을 만들 수 없으면 false
+        bool StartSerialCapture(const std::string &path);
+        void StopSerialCapture();
+        // 캡처의 수신 바이트를 디코딩/디스패치 경로에 다시 넣습니다. 로봇 없이 수신 경로를 재현하고 측정할 때 씁니다.
+        // speed 1.0은 기록된 속도, 2.0은 두 배 속도, 0은 기다리지 않고 최대 속도입니다. 기록된 속도로 재생하는
+        // 동안에는 이벤트 루프를 돌립니다. 재생한 응답은 캡처된 송신 프레임과 짝짓고 (GetServoData는 프레임의
+        // 관절 번호로), 지연 통계(GetLatencyStats)에는 반영하지 않습니다. 포트가 열려 있거나 자동 폴링 중이면
+        // 재생하지 않고 error를 채워 반환합니다.
+        ReplayStats ReplaySerialCapture(const std::string &path, double speed = 0.0);
 
         void RequestAngles();
         void RequestSpeeds();
         void RequestCoords();
+        // 스케줄러를 거쳐 부하를 요청합니다. (scheduleRequest(REQ_Loads, joint)와 같음)
         void RequestJointLoad(Joint joint);
+        // J1~J6 부하 요청을 대기열에 넣습니다. 응답에 관절 번호가 없으므로 한 관절씩 차례로 보내며 (앞 관절의 응답이
+        // 온 뒤 다음 관절), 여섯 개가 모두 도착하면 LoadSweep으로 갱신됩니다.
+        // 대기열이 가득 차 일부를 넣지 못하거나 부하 요청이 타임아웃되면 그 스윕은 바로 abandoned로 셉니다.
+        void RequestLoadSweep();
         void RequestIsMoving();
         void RequestVoltages();
 
         // ======================================================================
         // API 그룹 3: 캐시된 데이터 조회 (Peek - Non-blocking)
         // ======================================================================
+        // 어느 스레드에서나 락 없이 호출할 수 있습니다. 다른 스레드에서는 패킷 하나를 처리할 때마다
+        // seqlock으로 게시되는 스냅샷을 읽으므로 값이 섞이지(tearing) 않습니다.
+        RobotState PeekState() const;
         Angles PeekAngles() const;
         Coords PeekCoords() const;
+        Angles PeekEncoders() const;
         IntAngles PeekSpeeds() const;
         Voltages PeekVoltages() const;
         int PeekJointLoad(Joint joint) const;
+        LoadSweep PeekLoadSweep() const;
         bool PeekIsMoving() const; // CheckRunning의 비동기 버전
+        // 값과 함께 요청 시각, 수신 시각, 채널별 갱신 번호를 돌려줍니다. (지연 보상, 오래된 값 거르기)
+        Sample<Angles> PeekAnglesSample() const;
+        Sample<Coords> PeekCoordsSample() const;
+        Sample<Angles> PeekEncodersSample() const;
+        Sample<IntAngles> PeekSpeedsSample() const;
+        Sample<Voltages> PeekVoltagesSample() const;
+        Sample<int> PeekJointLoadSample(Joint joint) const; // 잘못된 관절이면 value -1, sequence 0
+        Sample<bool> PeekIsMovingSample() const;
+        // GetAngles/GetEncoders 응답마다 관절별 필터로 추정한 위치/속도/가속도. GET_SERVO_SPEEDS를 폴링하지 않아도
+        // 관절 속도를 얻을 수 있습니다. sent_at/received_at은 마지막으로 반영한 응답의 값이고 추정 시각은 그 중간이며,
+        // sequence는 필터에 반영한 측정 수입니다. 응답 간격이 max_gap_ms보다 길면 필터를 처음부터 다시 시작합니다.
+        Sample<JointMotion> PeekJointMotion() const;
+        Sample<JointMotion> PeekEncoderMotion() const;
+        // 추정 필터의 시간 상수 (길수록 매끄럽고 느리게 반응)와 재시작 간격
+        void SetMotionEstimator(int time_constant_ms = 100, int max_gap_ms = 1000);
+        // time 시각의 관절 각도/좌표 추정값. 이력 안의 시각이면 앞뒤 측정을 보간하고, 마지막 측정 뒤이면
+        // 추정 속도로 외삽하되 마지막 명령(WriteAngles 등)의 목표를 넘지 않습니다. 측정 시각은 요청과 응답의 중간입니다.
+        // 외삽은 SetPredictionHorizon()의 한계까지만 진행하고, 그보다 멀면 uncertain입니다.
+        Estimate<Angles> PeekAnglesAt(std::chrono::steady_clock::time_point time) const;
+        Estimate<Coords> PeekCoordsAt(std::chrono::steady_clock::time_point time) const;
+        void SetPredictionHorizon(int max_extrapolation_ms = 200);
+        // 채널별 최근 수신 이력 (고정 크기, lock-free). 조회하려면 TelemetryHistory.hpp를 포함합니다.
+        const TelemetryHistory &History() const;
+        // 변경 알림 (기본: 꺼짐). 켠 채널의 값이 deadband보다 많이 바뀌면, 한 번의 수신 처리(readyRead 배치)가
+        // 끝날 때 해당 *Changed 시그널과 stateChanged를 한 번씩 보냅니다. 비교 기준은 마지막으로 알린 값입니다.
+        // deadband를 주지 않으면 Common.hpp의 AnglesEpsilon/CoordsEpsilon/EncodersEpsilon 등을 씁니다.
+        void SetChangeNotification(TelemetryChannel channel, bool enabled);
+        void SetChangeNotification(TelemetryChannel channel, bool enabled, double deadband);
 
         // ======================================================================
         // API 그룹 4: 동기 데이터 읽기 (내부 테스트 및 특수 목적용)
@@ -107,24 +430,87 @@ namespace rc
         Angles GetAngles();   // 동기 버전
         Angles GetEncoders(); // 동기 버전
 
+        // ======================================================================
+        // API 그룹 5: 비동기 조회 (Non-blocking)
+        // ======================================================================
+        // 요청 파이프라인으로 보내므로 여러 조회가 동시에 in-flight일 수 있습니다. 응답이나 타임아웃
+        // (SetRequestTimeout/SetRequestRetries) 시 이벤트 루프 스레드에서 콜백이 호출됩니다.
+        // future 버전은 타임아웃 시 std::runtime_error를 담습니다. 다른 스레드에서 호출하면 요청은 이벤트 루프
+        // 스레드로 넘겨져 그 스레드에서 보내지므로, 이벤트 루프가 돌고 있어야 합니다. 응답도 이벤트 루프가
+        // 처리하므로 이벤트 루프 스레드에서 future.get()으로 기다리면 안 됩니다.
+        void GetAnglesAsync(QueryCallback<Angles> done);
+        std::future<Angles> GetAnglesAsync();
+        void GetEncodersAsync(QueryCallback<Angles> done);
+        std::future<Angles> GetEncodersAsync();
+        void GetSpeedAsync(QueryCallback<double> done);
+        std::future<double> GetSpeedAsync();
+        void IsPowerOnAsync(QueryCallback<bool> done);
+        std::future<bool> IsPowerOnAsync();
+        void IsProgramPausedAsync(QueryCallback<bool> done);
+        std::future<bool> IsProgramPausedAsync();
+        void IsInPositionAsync(const Coords &coords, bool is_linear, QueryCallback<bool> done);
+        std::future<bool> IsInPositionAsync(const Coords &coords, bool is_linear);
+        void IsServoEnabledAsync(Joint j, QueryCallback<bool> done);
+        std::future<bool> IsServoEnabledAsync(Joint j);
+        void IsAllServoEnabledAsync(QueryCallback<bool> done);
+        std::future<bool> IsAllServoEnabledAsync();
+        void IsMovingAsync(QueryCallback<bool> done); // CheckRunning
+        std::future<bool> IsMovingAsync();
+
     protected:
         MyCobot();
 
     private:
         // --- 내부 헬퍼 함수 ---
-        std::vector<std::pair<unsigned char, QByteArray>> Parse(QByteArray &data);
+        void DispatchPacket(const PacketView &packet);
+        void EmitChangeNotifications();
+        // 수신 바이트를 디코더에 넣고 완성된 패킷을 모두 디스패치합니다. 디스패치한 패킷 수를 반환합니다.
+        std::size_t FeedReceivedBytes(const char *data, std::size_t size);
+        void CaptureBytes(bool transmit, const char *data, std::size_t size);
+        void OnPacketBatchDispatched();
+        void ArmRequestTimer();
+        void StopIoThread();
         void ResetInPositionFlag();
-        void SerialWrite(const QByteArray &data) const;
+        // 진행 중인 부하 스윕을 완성하지 못한 것으로 끝냅니다. (abandoned 증가, 받은 값은 버림)
+        void AbandonLoadSweep();
+        void CompilePollingPlan();
+        // 상태 캐시를 쓰는 스레드(이 객체의 스레드)이면 true
+        bool OnOwnerThread() const;
+        RobotState CollectState() const;
+        // 캐시를 스냅샷으로 게시합니다. 캐시를 쓰는 스레드에서만 호출합니다.
+        void PublishState();
+        // 위치 측정 하나를 관절 운동 추정 필터에 반영합니다. (측정 시각: 요청과 응답의 중간)
+        void UpdateMotionEstimate(MotionEstimator &estimator, SampleInfo &motion_info, const Angles &measured, const SampleInfo &info);
+        // 비동기 조회: 응답이 오면 error가 nullptr, 실패하면 이유를 담아 complete가 호출됩니다.
+        void StartQuery(RequestType request_type, Joint joint, std::function<void(const char *error)> complete,
+                        const Coords &coords = {}, bool is_linear = false);
+        void FinishQuery(uint32_t query_id, const char *error);
+        void OnMotionCommandSent();
+        void SerialWrite(const QByteArray &data);
+        void SerialWrite(const char *data, std::size_t size);
+        // 스택에서 인코딩된 고정 크기 프레임 (FrameSpec::Encode 결과)
+        template <std::size_t N>
+        void SerialWrite(const std::array<char, N> &frame)
+        {
+            SerialWrite(frame.data(), N);
+        }
+        // 동기 서보 데이터 읽기. 응답에 관절 번호가 없어 다른 GetServoData와 구별할 수 없으므로, 폴링의 부하 요청이
+        // in-flight이거나 재동기화 중이면 끝날 때까지 기다렸다가 보냅니다. 기다림과 응답을 합쳐 1초 안에 끝나지 않으면
+        // 타임아웃처럼 마지막으로 받은 값을 반환합니다.
         int GetServoData(Joint joint, int data_id, int mode = 0);
 
     private slots:
         // --- Qt 슬롯 ---
         void HandleReadyRead();
+        void DrainIoQueue(); // I/O 스레드 모드에서 수신 큐를 비웁니다.
+        void FlushTxQueue(); // 같은 이벤트 루프 턴에 쌓인 송신 프레임을 한 번에 씁니다.
+        void HandleBytesWritten(qint64 bytes);
         void HandleTimeout();
         void HandleError(QSerialPort::SerialPortError error);
         void pollNextData(); // 자동 폴링 타이머에 연결될 슬롯
         // ★★★ [신규] 큐에서 다음 요청을 처리하는 private 슬롯 ★★★
         void processNextRequestInQueue();
+        void HandleRequestTimeout();
 
     signals:
         // --- 동기 함수들을 깨우기 위한 시그널들 ---
@@ -141,25 +527,66 @@ namespace rc
         void programPausedStatusReceived();
         void speedReceived();
         void servoDataReceived();
+        void loadSweepReceived();
+        // --- 변경 알림 (SetChangeNotification): 수신 배치마다 채널별로 최대 한 번, 마지막 값으로 ---
+        void anglesChanged(const rc::Angles &angles);
+        void coordsChanged(const rc::Coords &coords);
+        void encodersChanged(const rc::Angles &encoders);
+        void speedsChanged(const rc::IntAngles &speeds);
+        void voltagesChanged(const rc::Voltages &voltages);
+        void jointLoadsChanged(const rc::IntAngles &loads, unsigned changed_joints); // changed_joints 비트 0 = J1
+        void movingChanged(bool moving);
+        // 위 시그널들을 보낸 뒤 배치마다 한 번 (비트 i = TelemetryChannel i)
+        void stateChanged(unsigned changed_channels);
         void coordsReceived();
 
     private:
         // ★★★ "항공 관제탑"의 핵심 멤버 변수들 ★★★
-        // 1. 요청 대기열 (착륙 대기 중인 비행기 목록)
-        std::queue<std::pair<RequestType, Joint>> m_request_queue;
-        // 2. 관제탑 상태 플래그 (활주로가 사용 중인지 여부)
-        bool m_scheduler_is_busy{false};
+        // 요청 대기열과 응답 대기 중인 요청들 (in-flight window)
+        std::unique_ptr<RequestPipeline> m_pipeline;
+        // 캡처 재생 중에만 있는, 캡처된 송신 프레임으로 만든 in-flight 목록 (재생한 응답은 이것과 짝짓습니다)
+        std::unique_ptr<RequestPipeline> m_replay_pipeline;
+        std::chrono::steady_clock::time_point m_replay_captured_at{}; // 재생 중인 레코드의 캡처 시각 (m_replay_pipeline 기준)
+        // 가장 이른 응답 deadline에 맞춰 울리는 타이머
+        QTimer m_request_timer;
+        // 응답을 기다리는 비동기 조회 (query_id -> 완료 콜백과 인자)
+        struct PendingQuery
+        {
+            std::function<void(const char *error)> complete{};
+            Coords coords{};
+            bool is_linear{false};
+        };
+        std::map<uint32_t, PendingQuery> m_queries;
+        uint32_t m_next_query_id{1};
         // --- 시리얼 통신 관련 ---
         QString m_port_name;
         int m_baud_rate;
         QSerialPort *serial_port{nullptr};
         QTimer *serial_timer{nullptr};
-        QByteArray read_data{};
         QString m_last_error_string;
+        std::unique_ptr<PacketDecoder> m_decoder; // 수신 스트림 디코더 (고정 크기 링 버퍼)
+        std::unique_ptr<LatencyTracker> m_latency; // 명령어별 왕복 지연 측정
+
+        // --- 송신 큐 (직접 모드) ---
+        QByteArray m_tx_buffer;          // 다음 FlushTxQueue()에서 쓸 프레임들
+        std::size_t m_tx_frames{0};      // m_tx_buffer에 쌓인 프레임 수
+        qint64 m_tx_bytes_in_flight{0};  // write() 했지만 bytesWritten으로 확인되지 않은 바이트
+        bool m_tx_flush_scheduled{false};
+
+        // --- I/O 스레드 모드 ---
+        bool m_io_thread_enabled{false};
+        QThread *m_io_thread{nullptr};
+        SerialWorker *m_io_worker{nullptr};
 
         // --- 자동 폴링 메커니즘 ---
         QTimer m_polling_timer;
-        int m_polling_counter{0};
+        uint64_t m_polling_counter{0};
+        int m_polling_interval_ms{50}; // 기본 틱의 상한
+        bool m_adaptive_polling{false};
+        std::unique_ptr<PollRateController> m_poll_rate; // 적응형 폴링 주기 제어
+        std::vector<PollingEntry> m_polling_plan;         // 사용자 계획 (비어 있으면 기본 계획)
+        std::unique_ptr<PollingSchedule> m_polling_schedule;
+        std::unique_ptr<MotionPollingPolicy> m_motion_polling; // 정지 시 폴링 줄이기
 
         // --- 로봇 상태 캐시 변수 ---
         bool is_controller_connected{false};
@@ -176,8 +603,41 @@ namespace rc
         Voltages real_cur_voltages{};
         IntAngles real_cur_loads{};
         int last_servo_data_value{0};
-        Joint m_last_requested_load_joint{J1};
+        // --- 6관절 부하 스윕 ---
+        IntAngles m_load_sweep_values{};  // 진행 중인 스윕에서 받은 값
+        unsigned m_load_sweep_mask{0};    // 진행 중인 스윕에서 받은 관절 비트 (J1 = bit 0)
+        bool m_load_sweep_active{false};
+        LoadSweep m_load_sweep{};         // 마지막으로 완성된 스윕
         bool is_in_position{false};
+        // 채널별 수신 정보 (값은 위 캐시에)
+        SampleInfo m_angles_info{};
+        SampleInfo m_coords_info{};
+        SampleInfo m_encoders_info{};
+        SampleInfo m_speeds_info{};
+        SampleInfo m_voltages_info{};
+        SampleInfo m_is_moving_info{};
+        std::array<SampleInfo, Joints> m_load_info{};
+        // 관절 운동 추정 (PeekJointMotion, PeekEncoderMotion)
+        std::unique_ptr<MotionEstimator> m_angle_estimator;
+        std::unique_ptr<MotionEstimator> m_encoder_estimator;
+        std::unique_ptr<MotionEstimator> m_coord_estimator;
+        SampleInfo m_joint_motion_info{};
+        SampleInfo m_encoder_motion_info{};
+        SampleInfo m_coord_motion_info{};
+        // 상태 예측 (PeekAnglesAt, PeekCoordsAt)
+        MotionCommand m_angle_command{};
+        MotionCommand m_coord_command{};
+        std::atomic<int> m_prediction_horizon_ms{200};
+        // 다른 스레드가 읽는 상태 스냅샷 (위 캐시의 복사본)
+        std::unique_ptr<SeqLock<RobotState>> m_state_snapshot;
+        // 채널별 수신 이력 (생성할 때 미리 할당)
+        std::unique_ptr<TelemetryHistory> m_history;
+        // 텔레메트리 파일 기록 (기록 큐는 생성할 때 미리 할당)
+        std::unique_ptr<TelemetryRecorder> m_recorder;
+        // 변경 알림 deadband 판단 (SetChangeNotification)
+        std::unique_ptr<ChangeFilter> m_change_filter;
+        // 시리얼 캡처 (캡처 중이 아니면 nullptr)
+        std::unique_ptr<SerialCaptureWriter> m_capture;
     };
 
 } // namespace rc
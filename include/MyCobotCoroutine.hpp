@@ -0,0 +1,404 @@
+#ifndef ROBOSIGNAL_MYCOBOTCOROUTINE_HPP
+#define ROBOSIGNAL_MYCOBOTCOROUTINE_HPP
+
+/**
+ * @file MyCobotCoroutine.hpp
+ * @brief rc::MyCobot 위의 C++20 코루틴 계층 (헤더 전용, 선택 사항)
+ *
+ * 비동기 조회(Get...Async 등)와 응답 시그널을 awaitable로 감싸서, 긴 순차 동작을
+ * 추측한 대기 시간 없이 작성할 수 있게 합니다. 코루틴은 Qt 이벤트 루프 스레드에서
+ * 실행되며, 응답을 처리하는 경로(응답 콜백/시그널)에서 바로 재개됩니다.
+ *
+ * @code
+ * rc::coro::Task<void> PickSequence(rc::coro::Robot &robot, rc::Angles target)
+ * {
+ *     robot.Raw().WriteAngles(target, 30);
+ *     co_await robot.untilStopped();
+ *     const rc::LoadSweep loads = co_await robot.loads();
+ *     robot.Raw().SetGriper(1);
+ *     co_await robot.sleep(std::chrono::milliseconds{300});
+ * }
+ *
+ * rc::coro::Robot robot;
+ * auto task = PickSequence(robot, target); // 바로 시작하며 app.exec() 안에서 진행됩니다.
+ * @endcode
+ *
+ * CMake 옵션 MYCOBOT_ENABLE_COROUTINES를 켜면 이 헤더를 쓰는 대상이 C++20으로 빌드됩니다.
+ */
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include <QObject>
+#include <QTimer>
+
+#include "MyCobot.hpp"
+
+namespace rc
+{
+    namespace coro
+    {
+
+        template <typename T>
+        class Task;
+
+        namespace detail
+        {
+            /// Task 결과 저장소 (값 또는 예외)
+            template <typename T>
+            struct TaskResult
+            {
+                std::optional<T> value{};
+                std::exception_ptr exception{};
+
+                template <typename U>
+                void return_value(U &&result) { value.emplace(std::forward<U>(result)); }
+                T Take()
+                {
+                    if (exception)
+                    {
+                        std::rethrow_exception(exception);
+                    }
+                    return std::move(*value);
+                }
+            };
+
+            template <>
+            struct TaskResult<void>
+            {
+                std::exception_ptr exception{};
+
+                void return_void() {}
+                void Take()
+                {
+                    if (exception)
+                    {
+                        std::rethrow_exception(exception);
+                    }
+                }
+            };
+
+            template <typename T>
+            struct TaskPromise : TaskResult<T>
+            {
+                std::coroutine_handle<> continuation{};
+                bool detached{false}; // Task 객체가 먼저 사라지면 코루틴이 끝날 때 스스로 정리합니다.
+
+                Task<T> get_return_object();
+                std::suspend_never initial_suspend() noexcept { return {}; }
+
+                struct FinalAwaiter
+                {
+                    bool await_ready() noexcept { return false; }
+                    std::coroutine_handle<> await_suspend(std::coroutine_handle<TaskPromise> handle) noexcept
+                    {
+                        TaskPromise &promise = handle.promise();
+                        if (promise.continuation)
+                        {
+                            return promise.continuation;
+                        }
+                        if (promise.detached)
+                        {
+                            handle.destroy();
+                        }
+                        return std::noop_coroutine();
+                    }
+                    void await_resume() noexcept {}
+                };
+                FinalAwaiter final_suspend() noexcept { return {}; }
+                void unhandled_exception() { this->exception = std::current_exception(); }
+            };
+
+            /**
+             * @brief 콜백 버전 비동기 조회를 awaitable로 바꿉니다.
+             * 실패하면 QueryResult::error를 담은 std::runtime_error를 던집니다.
+             */
+            template <typename T, typename Start>
+            class QueryAwaiter
+            {
+            public:
+                explicit QueryAwaiter(Start start_) : start(std::move(start_)) {}
+
+                bool await_ready() const noexcept { return false; }
+                bool await_suspend(std::coroutine_handle<> handle_)
+                {
+                    handle = handle_;
+                    start([this](const QueryResult<T> &result_)
+                          {
+                        result = result_;
+                        if (suspended)
+                        {
+                            handle.resume();
+                        } });
+                    // 콜백이 start() 안에서 바로 호출되었으면(거부 등) 멈추지 않고 계속합니다.
+                    suspended = !result.has_value();
+                    return suspended;
+                }
+                T await_resume()
+                {
+                    if (!result->ok)
+                    {
+                        throw std::runtime_error(result->error);
+                    }
+                    return result->value;
+                }
+
+            private:
+                Start start;
+                std::coroutine_handle<> handle{};
+                std::optional<QueryResult<T>> result{};
+                bool suspended{false};
+            };
+
+            template <typename T, typename Start>
+            QueryAwaiter<T, Start> MakeQueryAwaiter(Start start)
+            {
+                return QueryAwaiter<T, Start>(std::move(start));
+            }
+
+            /**
+             * @brief MyCobot 시그널이 오거나 timeout이 지나면 재개합니다. co_await 결과는 시그널을 받았는지 여부입니다.
+             */
+            template <typename Signal>
+            class SignalAwaiter
+            {
+            public:
+                SignalAwaiter(MyCobot &robot_, Signal signal_, std::chrono::milliseconds timeout_)
+                    : robot(robot_), signal(signal_), timeout(timeout_) {}
+
+                bool await_ready() const noexcept { return false; }
+                void await_suspend(std::coroutine_handle<> handle_)
+                {
+                    handle = handle_;
+                    // 연결과 타이머를 context에 묶어, 먼저 끝난 쪽이 나머지를 함께 정리하게 합니다.
+                    context = new QObject();
+                    QObject::connect(&robot, signal, context, [this]()
+                                     { Finish(true); });
+                    QTimer::singleShot(static_cast<int>(timeout.count()), context, [this]()
+                                       { Finish(false); });
+                }
+                bool await_resume() const noexcept { return fired; }
+
+            private:
+                void Finish(bool fired_)
+                {
+                    if (!context)
+                    {
+                        return;
+                    }
+                    fired = fired_;
+                    QObject::disconnect(&robot, signal, context, nullptr);
+                    context->deleteLater();
+                    context = nullptr;
+                    handle.resume();
+                }
+
+                MyCobot &robot;
+                Signal signal;
+                std::chrono::milliseconds timeout;
+                std::coroutine_handle<> handle{};
+                QObject *context{nullptr};
+                bool fired{false};
+            };
+
+            /// 지정한 시간 뒤 이벤트 루프에서 재개합니다.
+            struct SleepAwaiter
+            {
+                std::chrono::milliseconds duration;
+
+                bool await_ready() const noexcept { return duration.count() <= 0; }
+                void await_suspend(std::coroutine_handle<> handle)
+                {
+                    QTimer::singleShot(static_cast<int>(duration.count()), [handle]()
+                                       { handle.resume(); });
+                }
+                void await_resume() const noexcept {}
+            };
+        }
+
+        /**
+         * @brief 즉시 시작하는 코루틴 결과 타입.
+         *
+         * 다른 Task 안에서 co_await하면 끝날 때 이어서 재개됩니다. 최상위 Task는 객체를
+         * 들고 있다가 Done()/Get()으로 확인하거나, 버려도 됩니다(끝날 때 스스로 정리되며
+         * 그 경우 예외는 버려집니다).
+         */
+        template <typename T>
+        class [[nodiscard]] Task
+        {
+        public:
+            using promise_type = detail::TaskPromise<T>;
+
+            explicit Task(std::coroutine_handle<promise_type> handle_) : handle(handle_) {}
+            Task(Task &&other) noexcept : handle(std::exchange(other.handle, {})) {}
+            Task &operator=(Task &&other) noexcept
+            {
+                if (this != &other)
+                {
+                    Release();
+                    handle = std::exchange(other.handle, {});
+                }
+                return *this;
+            }
+            Task(const Task &) = delete;
+            Task &operator=(const Task &) = delete;
+            ~Task() { Release(); }
+
+            bool Done() const { return !handle || handle.done(); }
+            /// 끝난 Task의 결과. 코루틴이 던진 예외는 여기서 다시 던집니다.
+            T Get() { return handle.promise().Take(); }
+
+            bool await_ready() const noexcept { return handle.done(); }
+            void await_suspend(std::coroutine_handle<> awaiting) noexcept { handle.promise().continuation = awaiting; }
+            T await_resume() { return handle.promise().Take(); }
+
+        private:
+            void Release()
+            {
+                if (!handle)
+                {
+                    return;
+                }
+                if (handle.done())
+                {
+                    handle.destroy();
+                }
+                else
+                {
+                    handle.promise().detached = true;
+                }
+                handle = {};
+            }
+
+            std::coroutine_handle<promise_type> handle;
+        };
+
+        template <typename T>
+        Task<T> detail::TaskPromise<T>::get_return_object()
+        {
+            return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+        }
+
+        /**
+         * @brief rc::MyCobot의 조회와 대기를 awaitable로 제공합니다.
+         *
+         * 모든 조회는 요청 파이프라인을 거치며, 응답이 없으면(타임아웃/재시도 소진)
+         * std::runtime_error를 던집니다.
+         */
+        class Robot
+        {
+        public:
+            static constexpr std::chrono::milliseconds DefaultPollInterval{50};
+            static constexpr std::chrono::milliseconds DefaultTimeout{30000};
+            // 동작 명령 직후의 "정지" 보고는 아직 출발 전일 수 있으므로 이 시간 동안은 무시합니다.
+            static constexpr std::chrono::milliseconds StartGrace{300};
+
+            explicit Robot(MyCobot &robot_ = MyCobot::Instance()) : robot(robot_) {}
+
+            MyCobot &Raw() { return robot; }
+
+            auto angles()
+            {
+                return detail::MakeQueryAwaiter<Angles>([this](QueryCallback<Angles> done)
+                                                        { robot.GetAnglesAsync(std::move(done)); });
+            }
+            auto encoders()
+            {
+                return detail::MakeQueryAwaiter<Angles>([this](QueryCallback<Angles> done)
+                                                        { robot.GetEncodersAsync(std::move(done)); });
+            }
+            auto speed()
+            {
+                return detail::MakeQueryAwaiter<double>([this](QueryCallback<double> done)
+                                                        { robot.GetSpeedAsync(std::move(done)); });
+            }
+            auto isPowerOn()
+            {
+                return detail::MakeQueryAwaiter<bool>([this](QueryCallback<bool> done)
+                                                      { robot.IsPowerOnAsync(std::move(done)); });
+            }
+            auto isMoving()
+            {
+                return detail::MakeQueryAwaiter<bool>([this](QueryCallback<bool> done)
+                                                      { robot.IsMovingAsync(std::move(done)); });
+            }
+            auto isInPosition(const Coords &coords, bool is_linear)
+            {
+                return detail::MakeQueryAwaiter<bool>([this, coords, is_linear](QueryCallback<bool> done)
+                                                      { robot.IsInPositionAsync(coords, is_linear, std::move(done)); });
+            }
+
+            /// 이벤트 루프를 막지 않고 기다립니다.
+            detail::SleepAwaiter sleep(std::chrono::milliseconds duration) { return {duration}; }
+
+            /// J1~J6 부하 스윕을 요청하고 여섯 관절이 모두 도착하면 결과를 돌려줍니다.
+            Task<LoadSweep> loads(std::chrono::milliseconds timeout = std::chrono::milliseconds{1000})
+            {
+                robot.RequestLoadSweep();
+                const bool received = co_await detail::SignalAwaiter(robot, &MyCobot::loadSweepReceived, timeout);
+                if (!received)
+                {
+                    throw std::runtime_error("Timeout: load sweep did not complete.");
+                }
+                co_return robot.PeekLoadSweep();
+            }
+
+            /// CheckRunning이 정지를 보고할 때까지 기다립니다.
+            Task<void> untilStopped(std::chrono::milliseconds timeout = DefaultTimeout,
+                                    std::chrono::milliseconds poll_interval = DefaultPollInterval)
+            {
+                const auto started = std::chrono::steady_clock::now();
+                bool seen_moving = false;
+                for (;;)
+                {
+                    const bool moving = co_await isMoving();
+                    const auto elapsed = std::chrono::steady_clock::now() - started;
+                    if (moving)
+                    {
+                        seen_moving = true;
+                    }
+                    else if (seen_moving || elapsed >= StartGrace)
+                    {
+                        co_return;
+                    }
+                    if (elapsed >= timeout)
+                    {
+                        throw std::runtime_error("Timeout: robot did not stop.");
+                    }
+                    co_await sleep(poll_interval);
+                }
+            }
+
+            /// IsInPosition이 목표 도달을 보고할 때까지 기다립니다.
+            Task<void> inPosition(Coords coords, bool is_linear = true,
+                                  std::chrono::milliseconds timeout = DefaultTimeout,
+                                  std::chrono::milliseconds poll_interval = DefaultPollInterval)
+            {
+                const auto deadline = std::chrono::steady_clock::now() + timeout;
+                while (!(co_await isInPosition(coords, is_linear)))
+                {
+                    if (std::chrono::steady_clock::now() >= deadline)
+                    {
+                        throw std::runtime_error("Timeout: robot did not reach the target position.");
+                    }
+                    co_await sleep(poll_interval);
+                }
+            }
+
+        private:
+            MyCobot &robot;
+        };
+
+    } // namespace coro
+} // namespace rc
+
+#endif // __cpp_impl_coroutine
+
+#endif // ROBOSIGNAL_MYCOBOTCOROUTINE_HPP
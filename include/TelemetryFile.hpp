@@ -0,0 +1,176 @@
+#ifndef ROBOSIGNAL_TELEMETRYFILE_HPP
+#define ROBOSIGNAL_TELEMETRYFILE_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "robosignal_global.hpp"
+#include "MyCobot.hpp"
+
+namespace rc
+{
+
+    /**
+     * 텔레메트리 기록 파일 형식 (버전 1, 호스트 바이트 순서)
+     *
+     *   [파일 헤더 (TelemetryHeaderSize)] [블록 0] [블록 1] ...
+     *
+     * 파일은 고정 크기 블록(TelemetryBlockSize)의 연속이고, 블록 하나는 한 채널(열)의 레코드만 담습니다.
+     * 레코드는 고정 폭(TelemetryRecordHeader + 채널 값)이며, 채널마다 수신 시각 순서로 쌓입니다.
+     * 블록 헤더의 first_ns/last_ns가 시간 색인 역할을 하므로, 읽을 때는 블록 헤더만 훑은 뒤
+     * 이진 탐색으로 시각을 찾습니다. 블록 헤더의 count는 레코드를 다 쓴 뒤에 늘리므로,
+     * 기록 중에 프로세스가 죽어도 count까지의 레코드는 온전합니다.
+     */
+    constexpr uint32_t TelemetryFileMagic = 0x4D4C5452;  // "RTLM"
+    constexpr uint32_t TelemetryBlockMagic = 0x4B4C4254; // "TBLK"
+    constexpr uint32_t TelemetryFileVersion = 1;
+    constexpr uint32_t TelemetryByteOrderMark = 0x01020304;
+    constexpr std::size_t TelemetryHeaderSize = 4096;
+    constexpr std::size_t TelemetryBlockSize = 64 * 1024;
+
+    /// 채널 값의 바이트 수 (Angles: double x 6, Speeds: int x 6, LoadJn: int, IsMoving: bool ...)
+    ROBOSIGNALSHARED_EXPORT std::size_t TelemetryValueSize(TelemetryChannel channel);
+    /// 레코드 하나의 바이트 수 (8바이트 정렬)
+    ROBOSIGNALSHARED_EXPORT std::size_t TelemetryRecordSize(TelemetryChannel channel);
+    ROBOSIGNALSHARED_EXPORT const char *TelemetryChannelName(TelemetryChannel channel);
+
+    struct TelemetryFileHeader
+    {
+        uint32_t magic{TelemetryFileMagic};
+        uint32_t version{TelemetryFileVersion};
+        uint32_t byte_order{TelemetryByteOrderMark};
+        uint32_t header_size{static_cast<uint32_t>(TelemetryHeaderSize)};
+        uint32_t block_size{static_cast<uint32_t>(TelemetryBlockSize)};
+        uint32_t channel_count{static_cast<uint32_t>(TelemetryChannelCount)};
+        int64_t start_steady_ns{0}; // 기록을 시작한 시각 (steady_clock)
+        int64_t start_system_ns{0}; // 같은 시각의 system_clock (벽시계 변환용)
+        uint64_t block_count{0};    // 할당된 블록 수 (정상 종료 시 갱신)
+        uint16_t record_size[TelemetryChannelCount]{};
+    };
+
+    struct TelemetryBlockHeader
+    {
+        uint32_t magic{0};
+        uint16_t channel{0};
+        uint16_t record_size{0};
+        uint32_t count{0};    // 다 쓴 레코드 수
+        uint32_t capacity{0}; // 이 블록에 들어가는 레코드 수
+        int64_t first_ns{0};  // 첫 레코드의 received_at (steady_clock)
+        int64_t last_ns{0};   // 마지막 레코드의 received_at
+        uint8_t reserved[32]{};
+    };
+
+    /// 레코드 앞부분. 바로 뒤에 채널 값(TelemetryValueSize 바이트)이 이어집니다.
+    struct TelemetryRecordHeader
+    {
+        int64_t received_ns{0};
+        int64_t sent_ns{0};
+        uint64_t sequence{0};
+    };
+
+    static_assert(sizeof(TelemetryFileHeader) <= TelemetryHeaderSize, "telemetry file header too large");
+    static_assert(sizeof(TelemetryBlockHeader) == 64, "telemetry block header must be 64 bytes");
+    static_assert(sizeof(TelemetryRecordHeader) == 24, "telemetry record header must be 24 bytes");
+
+    inline int64_t ToTelemetryNs(std::chrono::steady_clock::time_point time)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    }
+
+    inline std::chrono::steady_clock::time_point FromTelemetryNs(int64_t ns)
+    {
+        return std::chrono::steady_clock::time_point(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(ns)));
+    }
+
+    /**
+     * @brief 텔레메트리 기록 파일을 메모리 매핑해 읽습니다. (텍스트 파싱 없음)
+     *
+     * 기록 중인 파일도 열 수 있으며, Open() 시점까지 완료된 레코드만 보입니다.
+     * 인덱스는 채널별로 0부터 시각 순서입니다.
+     *
+     *     TelemetryReader reader;
+     *     reader.Open("arm.rtlm");
+     *     reader.ForEach<Angles>(TelemetryChannel::CH_Angles, from, to, [](const Sample<Angles> &s) { ... });
+     */
+    class ROBOSIGNALSHARED_EXPORT TelemetryReader
+    {
+    public:
+        TelemetryReader() = default;
+        ~TelemetryReader();
+
+        TelemetryReader(const TelemetryReader &) = delete;
+        TelemetryReader &operator=(const TelemetryReader &) = delete;
+
+        /// 실패하면 false를 반환하고 ErrorString()에 이유를 남깁니다.
+        bool Open(const std::string &path);
+        void Close();
+        bool IsOpen() const { return data != nullptr; }
+        const std::string &ErrorString() const { return error_string; }
+
+        /// 기록을 시작한 시각 (steady_clock, 기록한 머신 기준)
+        std::chrono::steady_clock::time_point StartTime() const;
+        /// 기록 파일의 steady_clock 시각을 벽시계 시각으로 바꿉니다.
+        std::chrono::system_clock::time_point ToSystemTime(std::chrono::steady_clock::time_point time) const;
+
+        std::size_t Count(TelemetryChannel channel) const;
+        /// received_at이 time 이상인 첫 레코드의 인덱스 (없으면 Count())
+        std::size_t LowerBound(TelemetryChannel channel, std::chrono::steady_clock::time_point time) const;
+
+        /// index번째 레코드를 읽습니다. 범위를 벗어나거나 T가 채널 값과 크기가 다르면 false
+        template <typename T>
+        bool Read(TelemetryChannel channel, std::size_t index, Sample<T> &sample) const
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "telemetry value must be trivially copyable");
+            const unsigned char *record = Record(channel, index);
+            if (!record || sizeof(T) != TelemetryValueSize(channel))
+            {
+                return false;
+            }
+            TelemetryRecordHeader record_header;
+            std::memcpy(&record_header, record, sizeof(record_header));
+            sample.sent_at = FromTelemetryNs(record_header.sent_ns);
+            sample.received_at = FromTelemetryNs(record_header.received_ns);
+            sample.sequence = record_header.sequence;
+            std::memcpy(static_cast<void *>(&sample.value), record + sizeof(record_header), sizeof(T));
+            return true;
+        }
+
+        /// received_at이 [from, to] 구간인 레코드마다 fn(const Sample<T> &)을 시각 순서로 호출합니다.
+        template <typename T, typename Fn>
+        void ForEach(TelemetryChannel channel, std::chrono::steady_clock::time_point from,
+                     std::chrono::steady_clock::time_point to, Fn &&fn) const
+        {
+            Sample<T> sample;
+            for (std::size_t index = LowerBound(channel, from); Read(channel, index, sample) && sample.received_at <= to; ++index)
+            {
+                fn(sample);
+            }
+        }
+
+    private:
+        struct Block
+        {
+            const unsigned char *records{nullptr};
+            std::size_t first_index{0}; // 채널 안에서 이 블록 첫 레코드의 인덱스
+            std::size_t count{0};
+            int64_t last_ns{0};
+        };
+
+        const unsigned char *Record(TelemetryChannel channel, std::size_t index) const;
+        bool Fail(const std::string &message);
+
+        const unsigned char *data{nullptr};
+        std::size_t size{0};
+        TelemetryFileHeader header{};
+        std::vector<Block> blocks[TelemetryChannelCount]{};
+        std::string error_string{};
+    };
+
+}
+#endif
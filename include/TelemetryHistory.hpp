@@ -0,0 +1,195 @@
+#ifndef ROBOSIGNAL_TELEMETRYHISTORY_HPP
+#define ROBOSIGNAL_TELEMETRYHISTORY_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "MyCobot.hpp"
+
+namespace rc
+{
+
+    /**
+     * @brief 타임스탬프가 붙은 샘플의 고정 크기 링 버퍼 (단일 쓰기, 다중 읽기, lock-free).
+     *
+     * 메모리는 생성할 때 한 번만 할당하고, 가득 차면 가장 오래된 샘플을 덮어씁니다.
+     * Push()는 한 스레드에서만 호출해야 하고 기다리지 않습니다. 조회 함수는 어느 스레드에서나
+     * 호출할 수 있습니다. 슬롯마다 "몇 번째 샘플인지"를 버전으로 기록해 두므로, 읽는 도중에
+     * 덮어쓰인 샘플은 섞이지 않고 결과에서 빠집니다.
+     */
+    template <typename T>
+    class SampleRing
+    {
+        static_assert(std::is_trivially_copyable_v<Sample<T>>, "SampleRing value must be trivially copyable");
+
+        static constexpr std::size_t WordCount = (sizeof(Sample<T>) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr std::size_t DefaultCapacity = 1024;
+
+        SampleRing() : SampleRing(DefaultCapacity) {}
+        /// capacity는 2의 거듭제곱으로 올림합니다.
+        explicit SampleRing(std::size_t capacity)
+            : mask(RoundUpPow2(capacity) - 1),
+              buffer(std::make_unique<Slot[]>(mask + 1))
+        {
+        }
+
+        SampleRing(const SampleRing &) = delete;
+        SampleRing &operator=(const SampleRing &) = delete;
+
+        void Push(const Sample<T> &sample)
+        {
+            std::array<uint64_t, WordCount> words{};
+            std::memcpy(words.data(), &sample, sizeof(Sample<T>));
+
+            const uint64_t index = head.load(std::memory_order_relaxed);
+            Slot &slot = buffer[index & mask];
+            slot.version.store(2 * index + 1, std::memory_order_relaxed); // 홀수: 쓰는 중
+            std::atomic_thread_fence(std::memory_order_release);
+            for (std::size_t i = 0; i < WordCount; ++i)
+            {
+                slot.words[i].store(words[i], std::memory_order_relaxed);
+            }
+            slot.version.store(2 * index + 2, std::memory_order_release);
+            head.store(index + 1, std::memory_order_release);
+        }
+
+        std::size_t Capacity() const { return mask + 1; }
+        /// 지금까지 넣은 샘플 수 (덮어쓴 것 포함)
+        uint64_t Pushed() const { return head.load(std::memory_order_acquire); }
+
+        /// 가장 최근 샘플. 비어 있으면 false
+        bool Latest(Sample<T> &sample) const
+        {
+            const uint64_t end = head.load(std::memory_order_acquire);
+            return end > 0 && Read(end - 1, sample);
+        }
+
+        /// 최근 n개 샘플 (오래된 것부터)
+        std::vector<Sample<T>> Last(std::size_t n) const
+        {
+            std::vector<Sample<T>> result;
+            ForEachNewest([&result, n](const Sample<T> &sample)
+                          {
+                if (result.size() >= n)
+                {
+                    return false;
+                }
+                result.push_back(sample);
+                return true; });
+            std::reverse(result.begin(), result.end());
+            return result;
+        }
+
+        /// received_at이 [from, to] 구간인 샘플 (오래된 것부터)
+        std::vector<Sample<T>> Between(Clock::time_point from, Clock::time_point to) const
+        {
+            std::vector<Sample<T>> result;
+            ForEachNewest([&result, from, to](const Sample<T> &sample)
+                          {
+                if (sample.received_at < from)
+                {
+                    return false;
+                }
+                if (sample.received_at <= to)
+                {
+                    result.push_back(sample);
+                }
+                return true; });
+            std::reverse(result.begin(), result.end());
+            return result;
+        }
+
+        /**
+         * @brief 최신 샘플부터 거꾸로 fn(const Sample<T> &)을 호출합니다. fn이 false를 반환하면 멈춥니다.
+         * 할당 없이 조회하고 싶을 때 사용합니다.
+         */
+        template <typename Fn>
+        void ForEachNewest(Fn &&fn) const
+        {
+            const uint64_t end = head.load(std::memory_order_acquire);
+            const uint64_t begin = end > Capacity() ? end - Capacity() : 0;
+            Sample<T> sample;
+            for (uint64_t index = end; index-- > begin;)
+            {
+                // 이미 덮어쓰였으면 그보다 오래된 샘플도 모두 덮어쓰인 것입니다.
+                if (!Read(index, sample) || !fn(sample))
+                {
+                    return;
+                }
+            }
+        }
+
+    private:
+        struct Slot
+        {
+            std::atomic<uint64_t> version{0}; // 2 * index + 2: index번째 샘플이 완전히 쓰인 상태
+            std::array<std::atomic<uint64_t>, WordCount> words{};
+        };
+
+        static std::size_t RoundUpPow2(std::size_t n)
+        {
+            std::size_t size = 1;
+            while (size < n)
+            {
+                size <<= 1;
+            }
+            return size;
+        }
+
+        bool Read(uint64_t index, Sample<T> &sample) const
+        {
+            const Slot &slot = buffer[index & mask];
+            const uint64_t expected = 2 * index + 2;
+            if (slot.version.load(std::memory_order_acquire) != expected)
+            {
+                return false;
+            }
+            std::array<uint64_t, WordCount> words{};
+            for (std::size_t i = 0; i < WordCount; ++i)
+            {
+                words[i] = slot.words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.version.load(std::memory_order_relaxed) != expected)
+            {
+                return false;
+            }
+            std::memcpy(static_cast<void *>(&sample), words.data(), sizeof(Sample<T>));
+            return true;
+        }
+
+        const std::size_t mask;
+        const std::unique_ptr<Slot[]> buffer;
+        alignas(64) std::atomic<uint64_t> head{0};
+    };
+
+    /**
+     * @brief 채널별 수신 이력. MyCobot이 디코딩 경로에서 채우며, MyCobot::History()로 조회합니다.
+     *
+     * 예: 최근 10개의 J3 부하 -> History().loads[J3 - 1].Last(10)
+     */
+    struct TelemetryHistory
+    {
+        SampleRing<Angles> angles{};
+        SampleRing<Coords> coords{};
+        SampleRing<Angles> encoders{};
+        SampleRing<IntAngles> speeds{};
+        SampleRing<Voltages> voltages{};
+        std::array<SampleRing<int>, Joints> loads{};
+        SampleRing<bool> is_moving{};
+    };
+
+}
+#endif
@@ -9,6 +9,8 @@
 #define MYCOBOTCPP_MYCOBOT_MYCOBOT_HPP
 
 #include <array>
+#include <chrono>
+#include <cstdint>
 #include <vector>
 #include <map>
 #include <memory>
@@ -42,9 +44,85 @@ namespace mycobot
     using Coords = std::array<double, Axes>;
     using Angles = std::array<double, Joints>;
     using IntAngles = std::array<int, Joints>; // 실시간 데이터용 정수 배열
+    using Voltages = std::array<double, Joints>;
 
     constexpr const int DefaultSpeed = 50;
 
+    /**
+     * @brief Round-trip latency of one command id (command sent -> response received).
+     */
+    struct LatencyStats
+    {
+        int command{0}; // Firmata command id (e.g. 0x20 GetAngles)
+        uint64_t count{0};
+        double p50_us{0.0};
+        double p99_us{0.0};
+        double max_us{0.0};
+        double mean_us{0.0};
+    };
+
+    /**
+     * @brief Cached telemetry value with its timing (std::chrono::steady_clock).
+     *
+     * sent_at is the time the request was sent (equal to received_at when no request
+     * could be matched). sequence counts updates of this channel, starting at 1;
+     * 0 means nothing has been received yet.
+     */
+    template <typename T>
+    struct Sample
+    {
+        T value{};
+        std::chrono::steady_clock::time_point sent_at{};
+        std::chrono::steady_clock::time_point received_at{};
+        uint64_t sequence{0};
+
+        bool Valid() const { return sequence != 0; }
+        /// Time since the value was received (duration::max() if never received).
+        std::chrono::steady_clock::duration Age(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) const
+        {
+            return Valid() ? now - received_at : std::chrono::steady_clock::duration::max();
+        }
+    };
+
+    /**
+     * @brief Filtered joint position, velocity and acceleration (per second, per second squared).
+     *
+     * Estimated from GetAngles (degrees) or GetEncoders (encoder ticks) responses, so joint
+     * velocities are available without polling GET_SERVO_SPEEDS.
+     */
+    struct JointMotion
+    {
+        Angles position{};
+        Angles velocity{};
+        Angles acceleration{};
+    };
+
+    /**
+     * @brief How PeekAnglesAt()/PeekCoordsAt() produced an estimate.
+     */
+    enum class EstimateKind
+    {
+        NoData,       ///< nothing received yet
+        Interpolated, ///< between the two measurements around the requested time
+        Extrapolated, ///< from the estimated motion, never past the last commanded target
+        Held,         ///< a measurement as is (e.g. the time is older than the kept history)
+    };
+
+    /**
+     * @brief State estimate at an arbitrary time.
+     *
+     * uncertain is set when the nearest measurement is further away than the prediction
+     * horizon, when a motion command was sent after the last measurement, or when there is no data.
+     */
+    template <typename T>
+    struct Estimate
+    {
+        T value{};
+        EstimateKind kind{EstimateKind::NoData};
+        bool uncertain{true};
+        std::chrono::steady_clock::duration horizon{}; ///< distance to the nearest measurement
+    };
+
     class MYCOBOTCPP_API MyCobotException : public std::runtime_error
     {
     public:
@@ -109,10 +187,33 @@ namespace mycobot
         IntAngles PeekSpeeds() const;
         int PeekJointLoad(Joint joint) const;
         bool PeekIsMoving() const;
+        // 값과 함께 요청/수신 시각과 갱신 번호 (지연 보상, 오래된 값 거르기)
+        Sample<Angles> PeekAnglesSample() const;
+        Sample<Coords> PeekCoordsSample() const;
+        Sample<Angles> PeekEncodersSample() const;
+        Sample<IntAngles> PeekSpeedsSample() const;
+        Sample<Voltages> PeekVoltagesSample() const;
+        Sample<int> PeekJointLoadSample(Joint joint) const;
+        Sample<bool> PeekIsMovingSample() const;
+        // 각도/엔코더 응답으로 추정한 관절 위치, 속도, 가속도 (sequence: 반영한 응답 수)
+        Sample<JointMotion> PeekJointMotion() const;
+        Sample<JointMotion> PeekEncoderMotion() const;
+        // 추정 필터의 시간 상수와, 필터를 다시 시작할 응답 간격
+        void SetMotionEstimator(int time_constant_ms = 100, int max_gap_ms = 1000);
+        // 임의 시각의 각도/좌표 (측정 사이는 보간, 마지막 측정 뒤는 명령 목표를 넘지 않게 외삽)
+        Estimate<Angles> PeekAnglesAt(std::chrono::steady_clock::time_point time) const;
+        Estimate<Coords> PeekCoordsAt(std::chrono::steady_clock::time_point time) const;
+        // 외삽 한계 (넘으면 uncertain)
+        void SetPredictionHorizon(int max_extrapolation_ms = 200);
 
         // --- 그리퍼 제어 ---
         void SetGriper(int open);
 
+        // --- 통신 진단 ---
+        LatencyStats GetLatencyStats(int command) const;
+        std::vector<LatencyStats> GetAllLatencyStats() const;
+        void ResetLatencyStats();
+
     private:
         std::shared_ptr<class MyCobotImpl> impl{};
     };
@@ -0,0 +1,113 @@
+#include "ChangeFilter.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace rc
+{
+
+    namespace
+    {
+        constexpr double VoltagesEpsilon = 0.1; // 전압 응답 해상도 (0.1 V)
+    }
+
+    double ChangeFilter::DefaultDeadband(TelemetryChannel channel)
+    {
+        switch (channel)
+        {
+        case TelemetryChannel::CH_Angles:
+            return AnglesEpsilon;
+        case TelemetryChannel::CH_Coords:
+            return CoordsEpsilon;
+        case TelemetryChannel::CH_Encoders:
+            return EncodersEpsilon;
+        case TelemetryChannel::CH_Voltages:
+            return VoltagesEpsilon;
+        case TelemetryChannel::CH_Speeds:
+        case TelemetryChannel::CH_IsMoving:
+        case TelemetryChannel::CH_LoadJ1:
+        case TelemetryChannel::CH_LoadJ2:
+        case TelemetryChannel::CH_LoadJ3:
+        case TelemetryChannel::CH_LoadJ4:
+        case TelemetryChannel::CH_LoadJ5:
+        case TelemetryChannel::CH_LoadJ6:
+        default:
+            return 0.0;
+        }
+    }
+
+    void ChangeFilter::SetEnabled(TelemetryChannel channel, bool enabled, double deadband)
+    {
+        const std::size_t index = Index(channel);
+        if (index >= TelemetryChannelCount)
+        {
+            return;
+        }
+        Channel &entry = channels[index];
+        entry.enabled = enabled;
+        entry.deadband = std::isfinite(deadband) ? std::max(deadband, 0.0) : 0.0;
+        entry.has_value = false; // 켜면 다음 값을 처음 값으로 알립니다.
+        if (enabled)
+        {
+            enabled_mask |= 1u << index;
+        }
+        else
+        {
+            enabled_mask &= ~(1u << index);
+            pending &= ~(1u << index);
+        }
+    }
+
+    void ChangeFilter::Offer(TelemetryChannel channel, const std::array<double, Joints> &value)
+    {
+        Offer(channel, value.data(), value.size());
+    }
+
+    void ChangeFilter::Offer(TelemetryChannel channel, const IntAngles &value)
+    {
+        std::array<double, Joints> values{};
+        std::copy(value.begin(), value.end(), values.begin());
+        Offer(channel, values.data(), values.size());
+    }
+
+    void ChangeFilter::Offer(TelemetryChannel channel, int value)
+    {
+        const double values[1] = {static_cast<double>(value)};
+        Offer(channel, values, 1);
+    }
+
+    void ChangeFilter::Offer(TelemetryChannel channel, bool value)
+    {
+        const double values[1] = {value ? 1.0 : 0.0};
+        Offer(channel, values, 1);
+    }
+
+    void ChangeFilter::Offer(TelemetryChannel channel, const double *values, std::size_t count)
+    {
+        const std::size_t index = Index(channel);
+        if (index >= TelemetryChannelCount || !channels[index].enabled)
+        {
+            return;
+        }
+        Channel &entry = channels[index];
+        bool changed = !entry.has_value;
+        for (std::size_t i = 0; i < count && !changed; ++i)
+        {
+            changed = std::fabs(values[i] - entry.notified[i]) > entry.deadband;
+        }
+        if (changed)
+        {
+            std::copy(values, values + count, entry.notified.begin());
+            entry.has_value = true;
+            pending |= 1u << index;
+        }
+    }
+
+    uint32_t ChangeFilter::TakePending()
+    {
+        const uint32_t result = pending;
+        pending = 0;
+        return result;
+    }
+
+}
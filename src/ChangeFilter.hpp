@@ -0,0 +1,56 @@
+#ifndef ROBOSIGNAL_CHANGEFILTER_HPP
+#define ROBOSIGNAL_CHANGEFILTER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "MyCobot.hpp"
+
+namespace rc
+{
+
+    /**
+     * @brief 채널 값이 deadband보다 많이 바뀌었는지 판단하고, 바뀐 채널을 한 배치 동안 모아 둡니다.
+     *
+     * 비교 대상은 마지막으로 "알린" 값이므로, 한 번에 deadband 안쪽으로 조금씩 움직여도
+     * 누적 변화가 deadband를 넘으면 알립니다. 채널의 요소 중 하나라도 |새 값 - 알린 값| > deadband이면
+     * 바뀐 것으로 봅니다 (deadband 0: 값이 조금이라도 바뀌면). 켜지 않은 채널은 무시합니다.
+     */
+    class ChangeFilter
+    {
+    public:
+        /// 채널별 기본 deadband (Common.hpp의 *Epsilon)
+        static double DefaultDeadband(TelemetryChannel channel);
+
+        void SetEnabled(TelemetryChannel channel, bool enabled, double deadband);
+        bool Enabled(TelemetryChannel channel) const { return channels[Index(channel)].enabled; }
+        bool AnyEnabled() const { return enabled_mask != 0; }
+
+        void Offer(TelemetryChannel channel, const std::array<double, Joints> &value);
+        void Offer(TelemetryChannel channel, const IntAngles &value);
+        void Offer(TelemetryChannel channel, int value);
+        void Offer(TelemetryChannel channel, bool value);
+
+        /// 이번 배치에서 바뀐 채널 (비트 i = TelemetryChannel i)을 돌려주고 비웁니다.
+        uint32_t TakePending();
+
+    private:
+        struct Channel
+        {
+            bool enabled{false};
+            bool has_value{false};         // 알린 값이 있는지 (첫 값은 항상 알림)
+            double deadband{0.0};
+            std::array<double, Joints> notified{};
+        };
+
+        static std::size_t Index(TelemetryChannel channel) { return static_cast<std::size_t>(channel); }
+        void Offer(TelemetryChannel channel, const double *values, std::size_t count);
+
+        std::array<Channel, TelemetryChannelCount> channels{};
+        uint32_t enabled_mask{0};
+        uint32_t pending{0};
+    };
+
+}
+#endif
@@ -1,5 +1,7 @@
 #include "Firmata.hpp"
 
+#include "PacketDecoder.hpp"
+
 #define log_category ::rc::log::robot_controller
 #include "log/Log.hpp"
 
@@ -70,6 +72,27 @@ namespace rc
         RETURNED_COMMAND_SIZES[GET_SERVO_TEMPS] = {12, 12};
     }
 
+    /**
+     * @brief Extract all complete packets from data.
+     * Parsed bytes (and leading garbage) are removed from data with a single
+     * remove() call; an incomplete trailing packet is left in place.
+     */
+    std::vector<std::pair<unsigned char, QByteArray>> Parse(QByteArray &data)
+    {
+        std::vector<std::pair<unsigned char, QByteArray>> parsed_commands;
+        PacketDecoder decoder(static_cast<std::size_t>(data.size()));
+        decoder.Feed(data.constData(), static_cast<std::size_t>(data.size()));
+
+        PacketView packet;
+        while (decoder.Next(packet))
+        {
+            parsed_commands.push_back({packet.command,
+                                       QByteArray(reinterpret_cast<const char *>(packet.data), static_cast<int>(packet.size))});
+        }
+        data.remove(0, data.size() - static_cast<int>(decoder.Size()));
+        return parsed_commands;
+    }
+
     /**
      * @brief Make command to be expected size, so that during parsing there is
      * no need for size checks.
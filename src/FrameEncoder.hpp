@@ -0,0 +1,153 @@
+#ifndef ROBOSIGNAL_FRAMEENCODER_HPP
+#define ROBOSIGNAL_FRAMEENCODER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "Common.hpp"
+#include "Firmata.hpp"
+
+namespace rc
+{
+
+    /**
+     * @brief 테이블 기반 Firmata 프레임 인코더.
+     *
+     * 각 명령어의 페이로드 레이아웃을 필드 타입 목록으로 선언하면, 프레임 크기와
+     * LEN 필드(페이로드 + 2)가 컴파일 시간에 계산됩니다. 인코딩 결과는 스택의
+     * std::array에 쓰이므로 힙 할당이 없습니다.
+     *
+     * 프레임: [0xFE, 0xFE, LEN, CMD, payload..., 0xFA]
+     */
+    namespace field
+    {
+        constexpr void PutInt16(char *out, int16_t value)
+        {
+            out[0] = static_cast<char>((value >> 8) & 0xFF); // MSB
+            out[1] = static_cast<char>(value & 0xFF);        // LSB
+        }
+
+        /// 1바이트 정수 (관절 ID, 속도, 모드 등)
+        struct U8
+        {
+            static constexpr std::size_t Size = 1;
+            static constexpr void Write(char *out, int value)
+            {
+                out[0] = static_cast<char>(value);
+            }
+        };
+
+        /// 배율(Scale)을 곱한 Big-Endian int16
+        template <int Scale>
+        struct I16
+        {
+            static constexpr std::size_t Size = 2;
+            static constexpr void Write(char *out, double value)
+            {
+                PutInt16(out, static_cast<int16_t>(value * Scale));
+            }
+        };
+
+        /// 같은 배율을 쓰는 N개의 Big-Endian int16 (관절 각도, 엔코더 등)
+        template <int Scale, std::size_t N>
+        struct I16Array
+        {
+            static constexpr std::size_t Size = 2 * N;
+            static constexpr void Write(char *out, const std::array<double, N> &values)
+            {
+                for (std::size_t i = 0; i < N; ++i)
+                {
+                    I16<Scale>::Write(out + 2 * i, values[i]);
+                }
+            }
+        };
+
+        /// 직교 좌표: X, Y, Z는 x10 (0.1mm), RX, RY, RZ는 x100 (0.01도)
+        struct CoordsI16
+        {
+            static constexpr std::size_t Size = 2 * Axes;
+            static constexpr void Write(char *out, const Coords &coords)
+            {
+                for (std::size_t i = 0; i < 3; ++i)
+                {
+                    I16<10>::Write(out + 2 * i, coords[i]);
+                }
+                for (std::size_t i = 3; i < static_cast<std::size_t>(Axes); ++i)
+                {
+                    I16<100>::Write(out + 2 * i, coords[i]);
+                }
+            }
+        };
+    }
+
+    template <Command Cmd, typename... Fields>
+    struct FrameSpec
+    {
+        static constexpr Command Id = Cmd;
+        static constexpr std::size_t PayloadSize = (std::size_t{0} + ... + Fields::Size);
+        static constexpr std::size_t FrameSize = 2 + 1 + 1 + PayloadSize + 1;
+        static_assert(PayloadSize + 2 <= 0xFF, "Firmata payload does not fit into LEN field");
+
+        using Buffer = std::array<char, FrameSize>;
+
+        template <typename... Args>
+        static constexpr Buffer Encode(const Args &...args)
+        {
+            static_assert(sizeof...(Args) == sizeof...(Fields), "Argument count does not match frame layout");
+            Buffer frame{};
+            frame[0] = static_cast<char>(0xFE);
+            frame[1] = static_cast<char>(0xFE);
+            frame[2] = static_cast<char>(PayloadSize + 2); // LEN = CMD(1) + LEN(1) + payload
+            frame[3] = static_cast<char>(Cmd);
+            [[maybe_unused]] std::size_t offset = 4; // 필드가 없는 프레임에서는 쓰이지 않습니다.
+            ((Fields::Write(frame.data() + offset, args), offset += Fields::Size), ...);
+            frame[FrameSize - 1] = static_cast<char>(0xFA);
+            return frame;
+        }
+    };
+
+    /// 명령어별 프레임 레이아웃 테이블
+    namespace frames
+    {
+        using namespace field;
+
+        using PowerOn = FrameSpec<Command::PowerOn>;
+        using IsPoweredOn = FrameSpec<Command::IsPoweredOn>;
+        using ReleaseAllServos = FrameSpec<Command::ReleaseAllServos>;
+        using SetFreshMode = FrameSpec<Command::SetFreshMode, U8>;
+
+        using GetAngles = FrameSpec<Command::GetAngles>;
+        using WriteAngle = FrameSpec<Command::WriteAngle, U8, I16<100>, U8>;     // joint, angle, speed
+        using WriteAngles = FrameSpec<Command::WriteAngles, I16Array<100, Joints>, U8>; // angles, speed
+        using GetCoords = FrameSpec<Command::GetCoords>;
+        using WriteCoord = FrameSpec<Command::WriteCoord, U8, I16<10>, U8>;      // axis, value, speed
+        using WriteCoords = FrameSpec<Command::WriteCoords, CoordsI16, U8, U8>;  // coords, speed, mode
+        using ProgramPause = FrameSpec<Command::ProgramPause>;
+        using IsProgramPaused = FrameSpec<Command::IsProgramPaused>;
+        using ProgramResume = FrameSpec<Command::ProgramResume>;
+        using TaskStop = FrameSpec<Command::TaskStop>;
+        using IsInPositionCoords = FrameSpec<Command::IsInPosition, CoordsI16, U8>;             // coords, is_linear(1)
+        using IsInPositionAngles = FrameSpec<Command::IsInPosition, I16Array<100, Joints>, U8>; // angles, is_linear(0)
+        using CheckRunning = FrameSpec<Command::CheckRunning>;
+
+        using SetEncoder = FrameSpec<Command::SetEncoder, U8, I16<1>>;               // joint, encoder
+        using SetEncoders = FrameSpec<Command::SetEncoders, I16Array<1, Joints>, U8>; // encoders, speed
+        using GetEncoders = FrameSpec<Command::GetEncoders>;
+
+        using GetSpeed = FrameSpec<Command::GetSpeed>;
+        using SetSpeed = FrameSpec<Command::SetSpeed, U8>;
+
+        using IsServoEnabled = FrameSpec<Command::IsServoEnabled, U8>;
+        using IsAllServoEnabled = FrameSpec<Command::IsAllServoEnabled>;
+        using GetServoData = FrameSpec<Command::GetServoData, U8, U8>;           // joint, address (1바이트 읽기)
+        using GetServoData16 = FrameSpec<Command::GetServoData, U8, U8, U8>;     // joint, address, mode(1) (2바이트 읽기)
+
+        using GripperMode = FrameSpec<Command::GripperMode, U8, U8>; // open/close, speed
+
+        using GetServoSpeeds = FrameSpec<Command::GET_SERVO_SPEEDS>;
+        using GetServoVoltages = FrameSpec<Command::GET_SERVO_VOLTAGES>;
+    }
+
+}
+#endif
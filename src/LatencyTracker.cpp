@@ -0,0 +1,163 @@
+#include "LatencyTracker.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace rc
+{
+
+    void LatencyHistogram::Record(std::chrono::nanoseconds latency)
+    {
+        const double us = std::max(0.0, static_cast<double>(latency.count()) / 1000.0);
+        std::size_t index = 0;
+        if (us >= 1.0)
+        {
+            index = std::min(static_cast<std::size_t>(std::log2(us) * BucketsPerOctave), BucketCount - 1);
+        }
+        ++buckets[index];
+        ++count;
+        sum_us += us;
+        max_us = std::max(max_us, us);
+    }
+
+    void LatencyHistogram::Reset()
+    {
+        buckets.fill(0);
+        count = 0;
+        sum_us = 0.0;
+        max_us = 0.0;
+    }
+
+    double LatencyHistogram::PercentileUs(double q) const
+    {
+        if (count == 0)
+        {
+            return 0.0;
+        }
+        const auto rank = static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(count)));
+        uint64_t seen = 0;
+        for (std::size_t i = 0; i < BucketCount; ++i)
+        {
+            seen += buckets[i];
+            if (seen >= std::max<uint64_t>(rank, 1))
+            {
+                const double upper = std::exp2(static_cast<double>(i + 1) / BucketsPerOctave);
+                return std::min(upper, max_us);
+            }
+        }
+        return max_us;
+    }
+
+    LatencyTracker::LatencyTracker()
+    {
+        slot_index.fill(-1);
+    }
+
+    LatencyTracker::Slot *LatencyTracker::Find(unsigned char command)
+    {
+        const int8_t index = slot_index[command];
+        return index < 0 ? nullptr : &entries[static_cast<std::size_t>(index)];
+    }
+
+    const LatencyTracker::Slot *LatencyTracker::Find(unsigned char command) const
+    {
+        const int8_t index = slot_index[command];
+        return index < 0 ? nullptr : &entries[static_cast<std::size_t>(index)];
+    }
+
+    void LatencyTracker::OnSent(unsigned char command, Clock::time_point now)
+    {
+        Slot *slot = Find(command);
+        if (!slot)
+        {
+            if (used == MaxCommands)
+            {
+                return;
+            }
+            slot_index[command] = static_cast<int8_t>(used);
+            slot = &entries[used++];
+            slot->command = command;
+        }
+
+        // FIFO가 가득 차면 가장 오래된 시각을 덮어씁니다 (응답이 없는 명령).
+        if (slot->size == PendingPerCommand)
+        {
+            slot->head = (slot->head + 1) % PendingPerCommand;
+            --slot->size;
+        }
+        slot->pending[(slot->head + slot->size) % PendingPerCommand] = now;
+        ++slot->size;
+    }
+
+    bool LatencyTracker::OnReceived(unsigned char command, Clock::time_point now, Clock::time_point *sent_at)
+    {
+        Slot *slot = Find(command);
+        if (!slot)
+        {
+            return false;
+        }
+        while (slot->size > 0)
+        {
+            const Clock::time_point sent = slot->pending[slot->head];
+            slot->head = (slot->head + 1) % PendingPerCommand;
+            --slot->size;
+            if (now - sent <= StaleAfter)
+            {
+                slot->histogram.Record(now - sent);
+                if (sent_at)
+                {
+                    *sent_at = sent;
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void LatencyTracker::Fill(const Slot &slot, LatencyStats &stats)
+    {
+        stats.command = slot.command;
+        stats.count = slot.histogram.Count();
+        stats.p50_us = slot.histogram.PercentileUs(0.50);
+        stats.p99_us = slot.histogram.PercentileUs(0.99);
+        stats.max_us = slot.histogram.MaxUs();
+        stats.mean_us = slot.histogram.MeanUs();
+    }
+
+    bool LatencyTracker::Stats(unsigned char command, LatencyStats &stats) const
+    {
+        const Slot *slot = Find(command);
+        if (!slot || slot->histogram.Count() == 0)
+        {
+            return false;
+        }
+        Fill(*slot, stats);
+        return true;
+    }
+
+    std::vector<LatencyStats> LatencyTracker::AllStats() const
+    {
+        std::vector<LatencyStats> all;
+        for (std::size_t i = 0; i < used; ++i)
+        {
+            if (entries[i].histogram.Count() > 0)
+            {
+                LatencyStats stats;
+                Fill(entries[i], stats);
+                all.push_back(stats);
+            }
+        }
+        return all;
+    }
+
+    void LatencyTracker::Reset()
+    {
+        for (std::size_t i = 0; i < used; ++i)
+        {
+            entries[i].head = 0;
+            entries[i].size = 0;
+            entries[i].histogram.Reset();
+        }
+    }
+
+}
@@ -0,0 +1,92 @@
+#ifndef ROBOSIGNAL_LATENCYTRACKER_HPP
+#define ROBOSIGNAL_LATENCYTRACKER_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MyCobot.hpp"
+
+namespace rc
+{
+
+    /**
+     * @brief 고정 버킷 로그 스케일 지연 히스토그램 (할당 없음).
+     *
+     * 버킷 i는 [2^(i/4), 2^((i+1)/4)) 마이크로초 구간입니다. 즉 2배마다 4개 버킷이며,
+     * 백분위수 오차는 최대 약 19%입니다. 1us 미만은 0번, 약 16초 이상은 마지막 버킷에 들어갑니다.
+     */
+    class LatencyHistogram
+    {
+    public:
+        static constexpr int BucketsPerOctave = 4;
+        static constexpr int Octaves = 24;
+        static constexpr std::size_t BucketCount = BucketsPerOctave * Octaves;
+
+        void Record(std::chrono::nanoseconds latency);
+        void Reset();
+
+        uint64_t Count() const { return count; }
+        /// q는 0.0 ~ 1.0. 해당 버킷의 상한을 반환하며, 최댓값을 넘지 않습니다.
+        double PercentileUs(double q) const;
+        double MaxUs() const { return max_us; }
+        double MeanUs() const { return count > 0 ? sum_us / static_cast<double>(count) : 0.0; }
+
+    private:
+        std::array<uint32_t, BucketCount> buckets{};
+        uint64_t count{0};
+        double sum_us{0.0};
+        double max_us{0.0};
+    };
+
+    /**
+     * @brief 명령어 ID별 왕복 지연을 측정합니다.
+     *
+     * OnSent()는 보낸 시각을 명령어별 작은 FIFO에 넣고, OnReceived()는 같은 명령어의
+     * 가장 오래된 시각과 짝지어 히스토그램에 기록합니다. 응답이 없는 명령의 시각은
+     * StaleAfter가 지나면 버려지므로 나중 응답과 잘못 짝지어지지 않습니다.
+     * 추적 슬롯은 고정 개수이며 처음 보는 명령어에 순서대로 할당됩니다.
+     */
+    class LatencyTracker
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr std::size_t MaxCommands = 32;
+        static constexpr std::size_t PendingPerCommand = 8;
+        static constexpr std::chrono::milliseconds StaleAfter{1000};
+
+        LatencyTracker();
+
+        void OnSent(unsigned char command, Clock::time_point now);
+        /// 짝지어진 송신 시각이 있으면 지연을 기록하고 true를 반환합니다. sent_at에는 그 송신 시각을 씁니다.
+        bool OnReceived(unsigned char command, Clock::time_point now, Clock::time_point *sent_at = nullptr);
+
+        /// 측정된 적이 없는 명령어면 false
+        bool Stats(unsigned char command, LatencyStats &stats) const;
+        std::vector<LatencyStats> AllStats() const;
+        void Reset();
+
+    private:
+        struct Slot
+        {
+            unsigned char command{0};
+            std::array<Clock::time_point, PendingPerCommand> pending{};
+            std::size_t head{0};
+            std::size_t size{0};
+            LatencyHistogram histogram{};
+        };
+
+        Slot *Find(unsigned char command);
+        const Slot *Find(unsigned char command) const;
+        static void Fill(const Slot &slot, LatencyStats &stats);
+
+        std::array<int8_t, 256> slot_index{}; // 명령어 ID -> entries 인덱스 (-1: 없음)
+        std::array<Slot, MaxCommands> entries{};
+        std::size_t used{0};
+    };
+
+}
+#endif
@@ -0,0 +1,81 @@
+#include "MotionEstimator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace rc
+{
+
+    double WrapDegrees(double degrees)
+    {
+        return std::remainder(degrees, 360.0);
+    }
+
+    void MotionEstimator::SetTimeConstant(std::chrono::milliseconds time_constant_)
+    {
+        time_constant = std::max(time_constant_, std::chrono::milliseconds{1});
+    }
+
+    void MotionEstimator::SetMaxGap(std::chrono::milliseconds max_gap_)
+    {
+        max_gap = std::max(max_gap_, std::chrono::milliseconds{1});
+    }
+
+    bool MotionEstimator::Update(const Angles &measured, Clock::time_point time)
+    {
+        if (updates > 0 && time <= last_time)
+        {
+            return false; // 같은 시각이거나 순서가 뒤바뀐 측정
+        }
+        if (updates == 0 || time - last_time > max_gap)
+        {
+            state.position = measured;
+            state.velocity.fill(0.0);
+            state.acceleration.fill(0.0);
+            last_time = time;
+            updates = 1;
+            return true;
+        }
+
+        const double dt = std::chrono::duration<double>(time - last_time).count();
+        if (updates == 1)
+        {
+            for (std::size_t i = 0; i < Joints; ++i)
+            {
+                const double delta = measured[i] - state.position[i];
+                state.velocity[i] = ((wrap_mask & (1u << i)) != 0 ? WrapDegrees(delta) : delta) / dt;
+            }
+            state.position = measured;
+        }
+        else
+        {
+            const double theta = std::exp(-dt / std::chrono::duration<double>(time_constant).count());
+            const double one_minus = 1.0 - theta;
+            const double g = 1.0 - theta * theta * theta;
+            const double h = 1.5 * one_minus * one_minus * (1.0 + theta);
+            const double k = 0.5 * one_minus * one_minus * one_minus;
+            for (std::size_t i = 0; i < Joints; ++i)
+            {
+                // 등가속도 모델로 측정 시각까지 예측
+                const double position = state.position[i] + state.velocity[i] * dt + 0.5 * state.acceleration[i] * dt * dt;
+                const double velocity = state.velocity[i] + state.acceleration[i] * dt;
+                const bool wrapped = (wrap_mask & (1u << i)) != 0;
+                const double residual = wrapped ? WrapDegrees(measured[i] - position) : measured[i] - position;
+                state.position[i] = wrapped ? WrapDegrees(position + g * residual) : position + g * residual;
+                state.velocity[i] = velocity + h * residual / dt;
+                state.acceleration[i] += 2.0 * k * residual / (dt * dt);
+            }
+        }
+        last_time = time;
+        ++updates;
+        return true;
+    }
+
+    void MotionEstimator::Reset()
+    {
+        state = JointMotion{};
+        last_time = Clock::time_point{};
+        updates = 0;
+    }
+
+}
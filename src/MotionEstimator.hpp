@@ -0,0 +1,68 @@
+#ifndef ROBOSIGNAL_MOTIONESTIMATOR_HPP
+#define ROBOSIGNAL_MOTIONESTIMATOR_HPP
+
+#include <chrono>
+#include <cstdint>
+
+#include "MyCobot.hpp"
+
+namespace rc
+{
+
+    /// 각도 차이를 [-180, 180] 도로 접습니다.
+    double WrapDegrees(double degrees);
+
+    /**
+     * @brief 관절별 위치 측정값에서 위치/속도/가속도를 추정합니다. (등가속도 alpha-beta-gamma 필터)
+     *
+     * 측정마다 이전 상태를 측정 시각까지 예측한 뒤, 잔차 r = 측정값 - 예측 위치로 보정합니다.
+     *
+     *     위치   += g * r
+     *     속도   += h * r / dt
+     *     가속도 += 2k * r / dt²
+     *
+     * 이득은 fading-memory 필터의 값(g = 1 - θ³, h = 1.5 (1 - θ)² (1 + θ), k = 0.5 (1 - θ)³)이고,
+     * θ = exp(-dt / TimeConstant())로 측정 간격마다 다시 계산하므로 폴링 간격이 불규칙해도
+     * 같은 시간 상수로 반응합니다. 시간 상수가 길수록 매끄럽고 느립니다.
+     *
+     * 첫 측정은 위치만, 두 번째 측정은 차분으로 속도를 초기화합니다. 측정 간격이 MaxGap()보다 길면
+     * (폴링 중단, 재연결 등) 처음부터 다시 시작합니다. 시각이 이전 측정보다 늦지 않은 측정은 무시합니다.
+     * SetWrapMask()로 지정한 요소(좌표의 RX/RY/RZ 등)는 ±180도에서 넘어가는 각도로 보고 잔차를 최단 방향으로 계산합니다.
+     */
+    class MotionEstimator
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr std::chrono::milliseconds DefaultTimeConstant{100};
+        static constexpr std::chrono::milliseconds DefaultMaxGap{1000};
+
+        void SetTimeConstant(std::chrono::milliseconds time_constant_);
+        std::chrono::milliseconds TimeConstant() const { return time_constant; }
+        void SetMaxGap(std::chrono::milliseconds max_gap_);
+        std::chrono::milliseconds MaxGap() const { return max_gap; }
+        /// ±180도에서 넘어가는 요소 (비트 i = 요소 i)
+        void SetWrapMask(unsigned wrap_mask_) { wrap_mask = wrap_mask_; }
+        unsigned WrapMask() const { return wrap_mask; }
+
+        /// 측정값 하나를 반영합니다. 무시한 측정이면 false
+        bool Update(const Angles &measured, Clock::time_point time);
+        void Reset();
+
+        const JointMotion &State() const { return state; }
+        /// 마지막으로 반영한 측정 시각
+        Clock::time_point Time() const { return last_time; }
+        /// 반영한 측정 수 (Reset 후 0)
+        uint64_t Updates() const { return updates; }
+
+    private:
+        std::chrono::milliseconds time_constant{DefaultTimeConstant};
+        std::chrono::milliseconds max_gap{DefaultMaxGap};
+        unsigned wrap_mask{0};
+        JointMotion state{};
+        Clock::time_point last_time{};
+        uint64_t updates{0};
+    };
+
+}
+#endif
@@ -0,0 +1,61 @@
+#include "MotionPollingPolicy.hpp"
+
+#include <algorithm>
+
+namespace rc
+{
+
+    void MotionPollingPolicy::SetHeartbeat(std::chrono::milliseconds heartbeat_)
+    {
+        heartbeat = std::max(heartbeat_, std::chrono::milliseconds{1});
+    }
+
+    void MotionPollingPolicy::SetSettleTime(std::chrono::milliseconds settle_time_)
+    {
+        settle_time = std::max(settle_time_, std::chrono::milliseconds{0});
+    }
+
+    void MotionPollingPolicy::OnMotionCommand(Clock::time_point now)
+    {
+        last_activity = now;
+        // 명령 직후의 "정지" 보고는 아직 움직이기 전일 수 있으므로 settle time 동안은 Active로 둡니다.
+        last_report_moving = true;
+        idle_interval = std::chrono::milliseconds{0};
+    }
+
+    void MotionPollingPolicy::OnIsMoving(bool moving, Clock::time_point now)
+    {
+        last_report_moving = moving;
+        if (moving)
+        {
+            last_activity = now;
+            idle_interval = std::chrono::milliseconds{0};
+        }
+    }
+
+    MotionPollingPolicy::State MotionPollingPolicy::CurrentState(Clock::time_point now) const
+    {
+        if (!enabled)
+        {
+            return State::Disabled;
+        }
+        return !last_report_moving && now - last_activity >= settle_time ? State::Idle : State::Active;
+    }
+
+    std::chrono::milliseconds MotionPollingPolicy::NextInterval(std::chrono::milliseconds base_tick, Clock::time_point now)
+    {
+        switch (CurrentState(now))
+        {
+        case State::Idle:
+            // 기본 틱에서 시작해 틱마다 두 배로 늘려 heartbeat까지 줄입니다.
+            idle_interval = std::clamp(idle_interval * 2, base_tick, std::max(base_tick, heartbeat));
+            return idle_interval;
+        case State::Active:
+        case State::Disabled:
+        default:
+            idle_interval = std::chrono::milliseconds{0};
+            return base_tick;
+        }
+    }
+
+}
@@ -0,0 +1,64 @@
+#ifndef ROBOSIGNAL_MOTIONPOLLINGPOLICY_HPP
+#define ROBOSIGNAL_MOTIONPOLLINGPOLICY_HPP
+
+#include <chrono>
+
+namespace rc
+{
+
+    /**
+     * @brief 로봇의 움직임에 따라 폴링 틱 간격을 정합니다.
+     *
+     * 동작 명령을 보내거나 CheckRunning이 "움직이는 중"을 보고하면 Active 상태가 되어
+     * 기본 틱으로 폴링합니다. 마지막 움직임 이후 SettleTime() 동안 움직임이 없고,
+     * 가장 최근 CheckRunning 보고가 "정지"이면 Idle 상태가 되어 틱 간격이
+     * 틱마다 두 배씩 늘어나 Heartbeat()까지 줄어듭니다.
+     */
+    class MotionPollingPolicy
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        enum class State
+        {
+            Disabled, // 움직임과 무관하게 기본 틱
+            Active,
+            Idle,
+        };
+
+        static constexpr std::chrono::milliseconds DefaultHeartbeat{1000};
+        static constexpr std::chrono::milliseconds DefaultSettleTime{500};
+
+        void SetEnabled(bool enabled_) { enabled = enabled_; }
+        bool Enabled() const { return enabled; }
+        /// Idle 상태의 최대 틱 간격
+        void SetHeartbeat(std::chrono::milliseconds heartbeat);
+        std::chrono::milliseconds Heartbeat() const { return heartbeat; }
+        /// 마지막 움직임 이후 Idle로 넘어가기까지 기다리는 시간
+        void SetSettleTime(std::chrono::milliseconds settle_time);
+        std::chrono::milliseconds SettleTime() const { return settle_time; }
+
+        /// 동작 명령(WriteAngles 등)을 보냈을 때
+        void OnMotionCommand(Clock::time_point now);
+        /// CheckRunning 응답을 받았을 때
+        void OnIsMoving(bool moving, Clock::time_point now);
+
+        State CurrentState(Clock::time_point now) const;
+
+        /**
+         * @brief 다음 틱 간격을 정합니다. 폴링 틱마다 한 번 호출합니다.
+         * @param base_tick Active 상태의 틱 간격 (폴링 계획의 기본 틱)
+         */
+        std::chrono::milliseconds NextInterval(std::chrono::milliseconds base_tick, Clock::time_point now);
+
+    private:
+        bool enabled{false};
+        std::chrono::milliseconds heartbeat{DefaultHeartbeat};
+        std::chrono::milliseconds settle_time{DefaultSettleTime};
+        Clock::time_point last_activity{};
+        bool last_report_moving{true}; // 첫 보고 전에는 움직이는 것으로 봅니다.
+        std::chrono::milliseconds idle_interval{0};
+    };
+
+}
+#endif
@@ -21,9 +21,24 @@
 #include <QtSerialPort/qserialportinfo.h>
 #include <QElapsedTimer>
 
+#include "ChangeFilter.hpp"
 #include "Common.hpp"
 #include "Firmata.hpp"
+#include "FrameEncoder.hpp"
+#include "LatencyTracker.hpp"
+#include "PacketDecoder.hpp"
+#include "RequestPipeline.hpp"
+#include "MotionPollingPolicy.hpp"
+#include "MotionEstimator.hpp"
+#include "PollRateController.hpp"
+#include "PollingSchedule.hpp"
+#include "SeqLock.hpp"
+#include "SerialCapture.hpp"
+#include "SerialWorker.hpp"
+#include "StatePredictor.hpp"
 #include "SystemInfo.hpp"
+#include "TelemetryHistory.hpp"
+#include "TelemetryRecorder.hpp"
 #define log_category ::rc::log::robot_controller
 #include "log/Log.hpp"
 
@@ -40,22 +55,129 @@ namespace rc
         OTHER_STATE,
     };
 
-    MyCobot::MyCobot()                     // default 생성자 대신 다시 구현
-        : m_port_name("/dev/ttyJETCOBOT"), // ★★★ 이니셜라이저 리스트 사용 ★★★
+    namespace
+    {
+        /// 캐시에서 값을 읽어 QueryResult로 전달하는 조회 완료 함수를 만듭니다.
+        template <typename T, typename Read>
+        std::function<void(const char *)> Completion(QueryCallback<T> done, Read read)
+        {
+            return [done = std::move(done), read](const char *error)
+            {
+                QueryResult<T> result;
+                if (error)
+                {
+                    result.error = error;
+                }
+                else
+                {
+                    result.ok = true;
+                    result.value = read();
+                }
+                if (done)
+                {
+                    done(result);
+                }
+            };
+        }
+
+        /// 콜백 버전 조회를 future 버전으로 감쌉니다.
+        template <typename T, typename Start>
+        std::future<T> MakeFuture(Start start)
+        {
+            auto promise = std::make_shared<std::promise<T>>();
+            std::future<T> future = promise->get_future();
+            start([promise](const QueryResult<T> &result)
+                  {
+                if (result.ok)
+                {
+                    promise->set_value(result.value);
+                }
+                else
+                {
+                    promise->set_exception(std::make_exception_ptr(std::runtime_error(result.error)));
+                } });
+            return future;
+        }
+
+        constexpr unsigned AllJointsMask = (1u << Joints) - 1;
+        constexpr unsigned AllAxesMask = (1u << Axes) - 1;
+
+        unsigned AxisBit(int axis_or_joint)
+        {
+            return 1u << (axis_or_joint - 1);
+        }
+
+        MotionCommand MakeCommand(const Angles &target, unsigned mask, int speed)
+        {
+            MotionCommand command;
+            command.target = target;
+            command.mask = mask;
+            command.speed = speed;
+            command.sent_at = std::chrono::steady_clock::now();
+            return command;
+        }
+
+        template <typename T>
+        Sample<T> MakeSample(const T &value, const SampleInfo &info)
+        {
+            Sample<T> sample;
+            static_cast<SampleInfo &>(sample) = info;
+            sample.value = value;
+            return sample;
+        }
+    }
+
+    MyCobot::MyCobot() // default 생성자 대신 다시 구현
+        : m_pipeline(std::make_unique<RequestPipeline>()),
+          m_replay_pipeline(),
+          m_replay_captured_at(),
+          m_queries(),
+          m_port_name("/dev/ttyJETCOBOT"), // ★★★ 이니셜라이저 리스트 사용 ★★★
           m_baud_rate(1000000),
-          m_last_error_string("") // 멤버 변수 선언 시 초기화했다면 생략 가능
+          m_last_error_string(""), // 멤버 변수 선언 시 초기화했다면 생략 가능
+          m_decoder(std::make_unique<PacketDecoder>()),
+          m_latency(std::make_unique<LatencyTracker>()),
+          m_tx_buffer(),
+          m_poll_rate(std::make_unique<PollRateController>()),
+          m_polling_plan(),
+          m_polling_schedule(std::make_unique<PollingSchedule>()),
+          m_motion_polling(std::make_unique<MotionPollingPolicy>()),
+          m_angle_estimator(std::make_unique<MotionEstimator>()),
+          m_encoder_estimator(std::make_unique<MotionEstimator>()),
+          m_coord_estimator(std::make_unique<MotionEstimator>()),
+          m_state_snapshot(std::make_unique<SeqLock<RobotState>>()),
+          m_history(std::make_unique<TelemetryHistory>()),
+          m_recorder(std::make_unique<TelemetryRecorder>()),
+          m_change_filter(std::make_unique<ChangeFilter>()),
+          m_capture()
     {
+        // *Changed 시그널을 다른 스레드의 객체에 연결(queued)할 수 있도록 등록합니다.
+        qRegisterMetaType<rc::Angles>("rc::Angles");
+        qRegisterMetaType<rc::Coords>("rc::Coords");
+        qRegisterMetaType<rc::Voltages>("rc::Voltages");
+        qRegisterMetaType<rc::IntAngles>("rc::IntAngles");
+        m_tx_buffer.reserve(1024);
+        // 좌표의 회전(RX, RY, RZ)은 ±180도에서 넘어갑니다.
+        m_coord_estimator->SetWrapMask(AxisBit(RX) | AxisBit(RY) | AxisBit(RZ));
         // 객체 생성 및 시그널 연결 (프로그램 실행 중 한 번만 수행)
         serial_port = new QSerialPort(this);
         serial_timer = new QTimer(this);
         serial_timer->setSingleShot(true);
 
         connect(serial_port, &QSerialPort::readyRead, this, &MyCobot::HandleReadyRead);
+        connect(serial_port, &QSerialPort::bytesWritten, this, &MyCobot::HandleBytesWritten);
         connect(serial_timer, &QTimer::timeout, this, &MyCobot::HandleTimeout);
         // 시리얼 포트에서 에러가 발생하면 HandleError 슬롯을 호출하도록 연결합니다.
         connect(serial_port, &QSerialPort::errorOccurred, this, &MyCobot::HandleError);
         // ★★★ 자동 폴링 타이머의 timeout 시그널을 pollNextData 슬롯에 연결합니다. ★★★
         connect(&m_polling_timer, &QTimer::timeout, this, &MyCobot::pollNextData);
+        m_request_timer.setSingleShot(true);
+        connect(&m_request_timer, &QTimer::timeout, this, &MyCobot::HandleRequestTimeout);
+    }
+
+    MyCobot::~MyCobot()
+    {
+        StopIoThread();
     }
 
     MyCobot &MyCobot::Instance()
@@ -74,23 +196,49 @@ namespace rc
 
     int MyCobot::Connect() // InitSerialPort -> Connect
     {
-        if (serial_port->isOpen())
+        if (IsCncConnected())
         {
             return 0; // 이미 연결됨, 성공
         }
 
         LogInfo << "Trying to connect to port: " << m_port_name;
 
-        serial_port->setPortName(m_port_name);
-        serial_port->setBaudRate(m_baud_rate);
+        bool opened = false;
+        QSerialPort::SerialPortError error_code = QSerialPort::NoError;
+        QString error_string;
+        if (m_io_thread_enabled)
+        {
+            // 전용 I/O 스레드가 포트를 소유합니다. 수신 패킷은 DrainIoQueue()로 전달됩니다.
+            if (!m_io_thread)
+            {
+                m_io_thread = new QThread(this);
+                m_io_thread->setObjectName("mycobot-io");
+                m_io_worker = new SerialWorker([this]()
+                                               { QMetaObject::invokeMethod(this, &MyCobot::DrainIoQueue, Qt::QueuedConnection); });
+                m_io_worker->moveToThread(m_io_thread);
+                connect(m_io_worker, &SerialWorker::errorOccurred, this, &MyCobot::HandleError, Qt::QueuedConnection);
+                m_io_thread->start();
+            }
+            opened = m_io_worker->Open(m_port_name, m_baud_rate, error_code, error_string);
+        }
+        else
+        {
+            serial_port->setPortName(m_port_name);
+            serial_port->setBaudRate(m_baud_rate);
+            opened = serial_port->open(QIODevice::ReadWrite);
+            if (!opened)
+            {
+                error_code = serial_port->error();
+                error_string = serial_port->errorString();
+            }
+        }
 
-        if (!serial_port->open(QIODevice::ReadWrite))
+        if (!opened)
         {
             // ★★★ 예외 처리 추가 시작 ★★★
-            QSerialPort::SerialPortError error_code = serial_port->error();
-            std::string error_message = serial_port->errorString().toStdString();
+            std::string error_message = error_string.toStdString();
 
-            LogError << "Failed to open port " << m_port_name << ": " << serial_port->errorString();
+            LogError << "Failed to open port " << m_port_name << ": " << error_string;
 
             // 구체적인 오류 정보를 담아 예외를 던진다.
             // std::error_code를 사용하면, 고수준 API에서 잡아서 처리하기 용이하다.
@@ -110,47 +258,99 @@ namespace rc
     {
         LogTrace;
 
+        if (m_io_worker)
+        {
+            if (m_io_worker->IsOpen())
+            {
+                m_io_worker->Close();
+                LogInfo << "Port closed.";
+            }
+            return 0;
+        }
+
         // serial_port 포인터가 유효하고, 포트가 열려 있을 경우에만 close()를 호출
         if (serial_port && serial_port->isOpen())
         {
-            serial_port->close();
-            LogInfo << "Port closed.";
+            // 모아 둔 프레임(TaskStop, ReleaseAllServos 등)을 먼저 보내고, 포트 버퍼가 비워질 때까지 기다립니다.
+            FlushTxQueue();
+            // 쓰기 에러로 HandleError가 이미 포트를 닫았을 수 있습니다.
+            if (serial_port->isOpen())
+            {
+                if (serial_port->bytesToWrite() > 0 && !serial_port->waitForBytesWritten(SERIAL_TIMEOUT))
+                {
+                    LogWarn << "Closing the port before all queued bytes were written: " << serial_port->errorString();
+                }
+                serial_port->close();
+                LogInfo << "Port closed.";
+            }
         }
 
+        // 닫힌 포트의 bytesWritten은 오지 않습니다.
+        m_tx_buffer.clear();
+        m_tx_frames = 0;
+        m_tx_bytes_in_flight = 0;
+
         return 0;
     }
 
     bool MyCobot::IsCncConnected()
     {
+        if (m_io_worker)
+        {
+            return m_io_worker->IsOpen();
+        }
         return serial_port->isOpen();
     }
 
+    void MyCobot::SetIoThreadEnabled(bool enabled)
+    {
+        if (IsCncConnected())
+        {
+            LogWarn << "I/O thread mode can only be changed before Connect().";
+            return;
+        }
+        if (!enabled)
+        {
+            StopIoThread();
+        }
+        m_io_thread_enabled = enabled;
+    }
+
+    bool MyCobot::IsIoThreadEnabled() const
+    {
+        return m_io_thread_enabled;
+    }
+
+    void MyCobot::StopIoThread()
+    {
+        if (!m_io_thread)
+        {
+            return;
+        }
+        // 포트는 워커 스레드에서 닫은 뒤 스레드를 종료합니다.
+        if (m_io_worker->IsOpen())
+        {
+            m_io_worker->Close();
+        }
+        m_io_thread->quit();
+        m_io_thread->wait();
+        delete m_io_worker;
+        delete m_io_thread;
+        m_io_worker = nullptr;
+        m_io_thread = nullptr;
+    }
+
     void MyCobot::SetFreshMode(int mode)
     {
         // 명령어: [HEADER, HEADER, LEN(3), CMD(0x16), mode, FOOTER]
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-        command.append(char(3)); // Length
-        command.append(char(Command::SetFreshMode));
-        command.append(char(mode));
-        command.append(FIRMATA_FOOTER);
-        SerialWrite(command);
+        SerialWrite(frames::SetFreshMode::Encode(mode));
     }
 
     bool MyCobot::PowerOn()
     {
-        // PowerOn 명령어(0x10) 패킷을 직접 생성합니다.
-        // 이 명령어는 보통 별도의 파라미터가 없습니다.
-        // [HEADER, HEADER, LEN(3), CMD(0x10), FOOTER]
-
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-        command.append(char(2));                // LEN 필드. 프로토콜에 따라 값이 다를 수 있음.
-        command.append(char(Command::PowerOn)); // 0x10
-        command.append(FIRMATA_FOOTER);
-
-        // 생성된 명령어를 시리얼 포트로 직접 전송합니다.
-        SerialWrite(command);
+        // PowerOn 명령어(0x10)는 별도의 파라미터가 없습니다.
+        // [HEADER, HEADER, LEN(2), CMD(0x10), FOOTER]
+        SerialWrite(frames::PowerOn::Encode());
 
         // PowerOn 명령은 보통 별도의 응답(return value)이 없습니다.
         // 따라서 일단은 성공(true)으로 간주하고 반환합니다.
@@ -165,16 +365,11 @@ namespace rc
     {
         LogTrace << ": TaskStop";
 
-        // TaskStop 명령어(0x29) 패킷을 직접 생성
-        // [HEADER, HEADER, LEN(3), CMD(0x29), FOOTER]
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-        command.append(char(2));                 // LEN
-        command.append(char(Command::TaskStop)); // 0x29
-        command.append(FIRMATA_FOOTER);
-
-        // 직접 전송
-        SerialWrite(command);
+        // [HEADER, HEADER, LEN(2), CMD(0x29), FOOTER]
+        SerialWrite(frames::TaskStop::Encode());
+        m_angle_command = MotionCommand{};
+        m_coord_command = MotionCommand{};
+        PublishState();
 
         return 0;
     }
@@ -183,16 +378,8 @@ namespace rc
     {
         LogTrace;
 
-        // ProgramPause 명령어(0x26) 패킷을 직접 생성
-        // [HEADER, HEADER, LEN(3), CMD(0x26), FOOTER]
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-        command.append(char(2));                     // LEN
-        command.append(char(Command::ProgramPause)); // 0x26
-        command.append(FIRMATA_FOOTER);
-
-        // 직접 전송
-        SerialWrite(command);
+        // [HEADER, HEADER, LEN(2), CMD(0x26), FOOTER]
+        SerialWrite(frames::ProgramPause::Encode());
         return 0;
     }
 
@@ -200,50 +387,22 @@ namespace rc
     {
         LogTrace;
 
-        // ProgramResume 명령어(0x28) 패킷을 직접 생성
-        // [HEADER, HEADER, LEN(3), CMD(0x28), FOOTER]
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-        command.append(char(2));                      // LEN
-        command.append(char(Command::ProgramResume)); // 0x28
-        command.append(FIRMATA_FOOTER);
-
-        // 직접 전송
-        SerialWrite(command);
+        // [HEADER, HEADER, LEN(2), CMD(0x28), FOOTER]
+        SerialWrite(frames::ProgramResume::Encode());
         return 0;
     }
 
     void rc::MyCobot::ReleaseAllServos()
     {
         LogTrace;
-        // ReleaseAllServos 명령어(0x13) 패킷을 직접 생성
-        // [HEADER, HEADER, LEN(3), CMD(0x13), FOOTER]
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-        command.append(char(2));                         // LEN 필드
-        command.append(char(Command::ReleaseAllServos)); // 0x13
-        command.append(FIRMATA_FOOTER);
-
-        // 직접 전송
-        SerialWrite(command);
+        // [HEADER, HEADER, LEN(2), CMD(0x13), FOOTER]
+        SerialWrite(frames::ReleaseAllServos::Encode());
     }
 
     void MyCobot::SetSpeed(int percentage)
     {
-        // SetSpeed 명령어(0x41) 패킷을 직접 생성
-        // [HEADER, HEADER, LEN(4), CMD(0x41), PERCENT, FOOTER]
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-        command.append(char(3));                 // LEN 필드
-        command.append(char(Command::SetSpeed)); // 0x41
-
-        // 속도(백분율) 값을 1바이트로 추가
-        command.append(static_cast<char>(percentage));
-
-        command.append(FIRMATA_FOOTER);
-
-        // 직접 전송
-        SerialWrite(command);
+        // [HEADER, HEADER, LEN(3), CMD(0x41), PERCENT, FOOTER]
+        SerialWrite(frames::SetSpeed::Encode(percentage));
     }
 
     void MyCobot::WriteAngles(const Angles &angles, int speed)
@@ -252,55 +411,29 @@ namespace rc
         //    '제자리에 도착한 상태'가 아님을 표시합니다. 이 로직은 유지합니다.
         ResetInPositionFlag();
 
-        // 2. 명령어 패킷을 직접 생성합니다.
+        // 2. 명령 큐를 거치지 않고 시리얼 포트에 직접 전송합니다.
         // [HEADER, HEADER, LEN(15), CMD(0x22), J1_msb, J1_lsb, ..., J6_msb, J6_lsb, speed, FOOTER]
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-        command.append(char(15)); // Length: 6 joints * 2 bytes + speed 1 byte = 13. 헤더 내 len/cmd 포함 시 15
-        command.append(char(Command::WriteAngles));
-
-        // 6개 관절의 각도 값을 각각 Big-Endian 2바이트로 변환하여 추가합니다.
-        for (const double &angle : angles)
-        {
-            signed short centi_deg = static_cast<signed short>(angle * 100);
-            command.append(static_cast<char>((centi_deg >> 8) & 0xFF)); // MSB (상위 바이트)
-            command.append(static_cast<char>(centi_deg & 0xFF));        // LSB (하위 바이트)
-        }
-
-        // 속도 값을 추가합니다.
-        command.append(static_cast<char>(speed));
-        command.append(FIRMATA_FOOTER);
-
-        // 3. 명령 큐를 거치지 않고 시리얼 포트에 직접 전송합니다.
-        SerialWrite(command);
+        SerialWrite(frames::WriteAngles::Encode(angles, speed));
+        m_angle_command = MakeCommand(angles, AllJointsMask, speed);
+        m_coord_command = MotionCommand{};
+        OnMotionCommandSent();
     }
 
     void MyCobot::WriteAngle(Joint joint, double value, int speed)
     {
         ResetInPositionFlag();
 
-        // 1. 각도 값을 로봇이 이해하는 정수 형태로 변환합니다.
-        short angle_val = static_cast<short>(value * 100);
-
-        // 2. 명령어 패킷을 직접 생성합니다.
-        // [HEADER, HEADER, LEN(5), CMD(0x21), joint, angle_msb, angle_lsb, speed, FOOTER]
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-        command.append(char(6)); // ★★★ Length를 6에서 5로 수정 ★★★
-        command.append(char(Command::WriteAngle));
-        command.append(char(joint));
-
-        // 각도 값을 Big-Endian 2바이트로 분할
-        command.append(static_cast<char>((angle_val >> 8) & 0xFF));
-        command.append(static_cast<char>(angle_val & 0xFF));
-
-        // ★★★ 속도 값을 1바이트로 전송 ★★★
-        command.append(static_cast<char>(speed));
-
-        command.append(FIRMATA_FOOTER);
-
-        // 3. 시리얼 포트에 직접 전송합니다.
-        SerialWrite(command);
+        // [HEADER, HEADER, LEN(6), CMD(0x21), joint, angle_msb, angle_lsb, speed, FOOTER]
+        SerialWrite(frames::WriteAngle::Encode(joint, value, speed));
+        if (joint >= J1 && joint <= J6)
+        {
+            // 다른 관절은 멈춰 있을 것이므로 이 관절의 목표만 남깁니다.
+            Angles target = m_angle_command.target;
+            target[static_cast<std::size_t>(joint) - 1] = value;
+            m_angle_command = MakeCommand(target, AxisBit(joint), speed);
+            m_coord_command = MotionCommand{};
+        }
+        OnMotionCommandSent();
     }
 
     void MyCobot::WriteCoords(const Coords &coords, int speed, int mode)
@@ -308,40 +441,13 @@ namespace rc
         // 1. 새로운 움직임이 시작되었음을 캐시에 알림 (기존 로직 유지)
         ResetInPositionFlag();
 
-        // 2. 명령어 패킷을 직접 생성
-        // [HEADER, HEADER, LEN, CMD(0x25), X,Y,Z,RX,RY,RZ, SPEED, MODE, FOOTER]
-        // 데이터 길이: 좌표(6*2=12) + 속도(1) + 모드(1) = 14 바이트
-        // LEN 필드 값: 데이터 길이(14) + CMD(1) + LEN(1) = 16 (프로토콜 규칙에 따라 조정 필요)
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-        command.append(char(16));                   // LEN 필드 (규칙에 따라 15 또는 16일 수 있음)
-        command.append(char(Command::WriteCoords)); // 0x25
-
-        // 6개 좌표 값을 Big-Endian 2바이트로 변환하여 추가
-        // X, Y, Z 좌표 (10을 곱함)
-        for (int i = 0; i < 3; ++i)
-        {
-            signed short tenth_mm = static_cast<signed short>(coords[i] * 10);
-            command.append(static_cast<char>((tenth_mm >> 8) & 0xFF));
-            command.append(static_cast<char>(tenth_mm & 0xFF));
-        }
-        // RX, RY, RZ 좌표 (100을 곱함)
-        for (int i = 3; i < rc::Axes; ++i)
-        {
-            signed short centi_deg = static_cast<signed short>(coords[i] * 100);
-            command.append(static_cast<char>((centi_deg >> 8) & 0xFF));
-            command.append(static_cast<char>(centi_deg & 0xFF));
-        }
-
-        // 속도와 모드 추가
+        // 2. 명령 큐를 거치지 않고 시리얼 포트에 직접 전송
+        // [HEADER, HEADER, LEN(16), CMD(0x25), X,Y,Z,RX,RY,RZ, SPEED, MODE, FOOTER]
         // 속도 계산 로직은 원본 코드를 따름. 펌웨어에서 % 단위로 받을 수 있음.
-        command.append(static_cast<char>(speed * 100 / MaxLinearSpeed));
-        command.append(static_cast<char>(mode)); // Mode. 원본 코드의 '2'를 그대로 사용.
-
-        command.append(FIRMATA_FOOTER);
-
-        // 3. 명령 큐를 거치지 않고 시리얼 포트에 직접 전송
-        SerialWrite(command);
+        SerialWrite(frames::WriteCoords::Encode(coords, speed * 100 / MaxLinearSpeed, mode));
+        m_coord_command = MakeCommand(coords, AllAxesMask, speed);
+        m_angle_command = MotionCommand{};
+        OnMotionCommandSent();
     }
 
     void MyCobot::WriteCoord(Axis axis, double value, int speed)
@@ -349,58 +455,27 @@ namespace rc
         // 1. 새로운 움직임이 시작되었음을 캐시에 알림 (기존 로직 유지)
         ResetInPositionFlag();
 
-        // 2. 명령어 패킷을 직접 생성
-        // [HEADER, HEADER, LEN, CMD(0x24), AXIS, VALUE, SPEED, FOOTER]
-        // 데이터 길이: 축 ID(1) + 값(2) + 속도(1) = 4 바이트
-        // LEN 필드 값: 데이터 길이(4) + CMD(1) + LEN(1) = 6
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-        command.append(char(6));                   // LEN 필드
-        command.append(char(Command::WriteCoord)); // 0x24
-
-        // 축 ID 추가
-        command.append(char(axis));
-
-        // 좌표 값을 Big-Endian 2바이트로 변환하여 추가
-        // 원본 코드의 변환 로직(10 곱하기)을 그대로 따름
-        signed short tenth_mm = static_cast<signed short>(value * 10);
-        command.append(static_cast<char>((tenth_mm >> 8) & 0xFF));
-        command.append(static_cast<char>(tenth_mm & 0xFF));
-
-        // 속도 추가
-        command.append(static_cast<char>(speed * 100 / MaxLinearSpeed));
-
-        command.append(FIRMATA_FOOTER);
-
-        // 3. 명령 큐를 거치지 않고 시리얼 포트에 직접 전송
-        SerialWrite(command);
+        // 2. 명령 큐를 거치지 않고 시리얼 포트에 직접 전송
+        // [HEADER, HEADER, LEN(6), CMD(0x24), AXIS, VALUE, SPEED, FOOTER]
+        SerialWrite(frames::WriteCoord::Encode(axis, value, speed * 100 / MaxLinearSpeed));
+        if (axis >= X && axis <= RZ)
+        {
+            Coords target = m_coord_command.target;
+            target[static_cast<std::size_t>(axis) - 1] = value;
+            m_coord_command = MakeCommand(target, AxisBit(axis), speed);
+            m_angle_command = MotionCommand{};
+        }
+        OnMotionCommandSent();
     }
 
     void MyCobot::SetEncoders(const Angles &encoders, int speed)
     {
-        // SetEncoders 명령어(0x3C) 패킷을 직접 생성
-        // [HEADER, HEADER, LEN, CMD(0x3C), E1, E2, E3, E4, E5, E6, SPEED, FOOTER]
-        // 데이터 길이: 엔코더(6*2=12) + 속도(1) = 13 바이트
-        // LEN 필드 값: 13(데이터) + 1(CMD) + 1(LEN) = 15
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-        command.append(char(15));                   // LEN
-        command.append(char(Command::SetEncoders)); // 0x3C
-
-        // 6개 엔코더 값을 Big-Endian 2바이트로 변환하여 추가
-        for (const double &encoder_val : encoders)
-        {
-            signed short encoder = static_cast<signed short>(encoder_val);
-            command.append(static_cast<char>((encoder >> 8) & 0xFF));
-            command.append(static_cast<char>(encoder & 0xFF));
-        }
-
-        // 속도 추가
-        command.append(static_cast<char>(speed));
-        command.append(FIRMATA_FOOTER);
-
-        // 직접 전송
-        SerialWrite(command);
+        // [HEADER, HEADER, LEN(15), CMD(0x3C), E1, E2, E3, E4, E5, E6, SPEED, FOOTER]
+        SerialWrite(frames::SetEncoders::Encode(encoders, speed));
+        // 엔코더 목표는 각도/좌표 목표로 바꿀 수 없습니다.
+        m_angle_command = MotionCommand{};
+        m_coord_command = MotionCommand{};
+        OnMotionCommandSent();
         LogInfo << "SerialWrite SetEncoders";
     }
 
@@ -409,42 +484,15 @@ namespace rc
         if (joint < 0 || joint >= rc::Joints)
             return;
 
-        // SetEncoder 명령어(0x3A) 패킷을 직접 생성
-        // [HEADER, HEADER, LEN, CMD(0x3A), JOINT_ID, VALUE, FOOTER]
-        // 데이터 길이: 관절 ID(1) + 값(2) = 3 바이트
-        // LEN 필드 값: 3(데이터) + 1(CMD) + 1(LEN) = 5
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-        command.append(char(5));                   // LEN
-        command.append(char(Command::SetEncoder)); // 0x3A
-
-        // 관절 ID 추가
-        command.append(static_cast<char>(joint));
-
-        // 엔코더 값을 Big-Endian 2바이트로 변환하여 추가
-        signed short encoder = static_cast<signed short>(val);
-        command.append(static_cast<char>((encoder >> 8) & 0xFF));
-        command.append(static_cast<char>(encoder & 0xFF));
-
-        command.append(FIRMATA_FOOTER);
-
-        // 직접 전송
-        SerialWrite(command);
+        // [HEADER, HEADER, LEN(5), CMD(0x3A), JOINT_ID, VALUE, FOOTER]
+        SerialWrite(frames::SetEncoder::Encode(joint, val));
     }
 
     int MyCobot::SetGriper(int open)
     {
-        // 'open' 값에 따라 적절한 명령을 직접 전송
-        if (open == 1)
-        {
-            // 그리퍼 열기 명령 전송
-            SerialWrite(CommandSetGriperOpen); // CommandSetGriperOpen이 QByteArray로 정의되어 있다고 가정
-        }
-        else
-        {
-            // 그리퍼 닫기 명령 전송
-            SerialWrite(CommandSetGriperClose); // CommandSetGriperClose가 QByteArray로 정의되어 있다고 가정
-        }
+        // 'open' 값에 따라 그리퍼 열기(0) 또는 닫기(1) 명령을 직접 전송
+        // [HEADER, HEADER, LEN(4), CMD(0x66), STATE, SPEED(100), FOOTER]
+        SerialWrite(frames::GripperMode::Encode(open == 1 ? 0 : 1, 100));
 
         return 0;
     }
@@ -453,297 +501,911 @@ namespace rc
     {
         if (!m_polling_timer.isActive())
         {
-            m_polling_timer.start(interval_ms);
-            LogInfo << "Auto-polling started at " << interval_ms << "ms interval.";
+            m_adaptive_polling = false;
+            m_polling_interval_ms = std::max(1, interval_ms);
+            CompilePollingPlan();
+            m_polling_timer.start(static_cast<int>(m_polling_schedule->Tick().count()));
+            LogInfo << "Auto-polling started at " << m_polling_schedule->Tick().count() << "ms tick.";
         }
     }
 
+    /**
+     * @brief 적응형 자동 폴링을 시작합니다.
+     * 주기는 계획의 기본 틱(staleness budget 이하)에서 시작해, 폴링할 때마다 측정값으로 다시 정해집니다.
+     */
+    void MyCobot::startAdaptivePolling(double target_utilization, int staleness_budget_ms)
+    {
+        m_poll_rate->SetBaudRate(m_baud_rate);
+        m_poll_rate->SetTargetUtilization(target_utilization);
+        m_poll_rate->SetStalenessBudget(std::chrono::milliseconds{staleness_budget_ms});
+        m_adaptive_polling = true;
+        // 계획은 고정 주기 폴링과 같이 컴파일하고, 실제 틱 간격만 컨트롤러가 정합니다. (budget은 상한)
+        CompilePollingPlan();
+        const auto tick = PollingSchedule::AdaptiveTick(m_polling_schedule->Tick(), m_poll_rate->StalenessBudget());
+        m_poll_rate->Reset(tick);
+        m_polling_timer.start(static_cast<int>(tick.count()));
+        LogInfo << "Adaptive auto-polling started (target utilization " << m_poll_rate->TargetUtilization()
+                << ", staleness budget " << m_poll_rate->StalenessBudget().count() << "ms).";
+    }
+
     /**
      * @brief 데이터 자동 요청(폴링)을 중지합니다.
      */
     void MyCobot::stopAutoPolling()
     {
         m_polling_timer.stop();
+        m_adaptive_polling = false;
         LogInfo << "Auto-polling stopped.";
     }
 
+    PollingStats MyCobot::GetPollingStats() const
+    {
+        PollingStats stats;
+        stats.active = m_polling_timer.isActive();
+        stats.adaptive = m_adaptive_polling;
+        stats.interval_ms = m_polling_timer.interval();
+        if (m_adaptive_polling)
+        {
+            stats.target_utilization = m_poll_rate->TargetUtilization();
+            stats.utilization = m_poll_rate->Utilization();
+            stats.round_trip_us = m_poll_rate->RoundTripUs();
+            stats.bytes_per_poll = m_poll_rate->BytesPerPoll();
+            stats.over_budget = m_poll_rate->OverBudget();
+        }
+        stats.plan_utilization = m_polling_schedule->EstimatedUtilization();
+        stats.plan_degraded = m_polling_schedule->Degraded();
+        stats.idle = m_motion_polling->CurrentState(std::chrono::steady_clock::now()) == MotionPollingPolicy::State::Idle;
+        return stats;
+    }
+
+    void MyCobot::SetMotionAwarePolling(bool enabled, int heartbeat_ms, int settle_ms)
+    {
+        m_motion_polling->SetEnabled(enabled);
+        m_motion_polling->SetHeartbeat(std::chrono::milliseconds{heartbeat_ms});
+        m_motion_polling->SetSettleTime(std::chrono::milliseconds{settle_ms});
+        LogInfo << "Motion-aware polling " << (enabled ? "enabled" : "disabled") << " (heartbeat " << heartbeat_ms
+                << "ms, settle " << settle_ms << "ms).";
+    }
+
     /**
-     * @brief [private slot] 자동 폴링 타이머에 의해 주기적으로 호출됩니다.
-     * 라운드 로빈 방식으로 여러 데이터를 순차적으로 요청하여 통신 과부하를 방지합니다.
+     * @brief 동작 명령을 보낸 직후 호출됩니다. 정지 상태로 폴링을 줄이고 있었다면 바로 기본 틱으로 폴링합니다.
      */
-    void MyCobot::pollNextData()
+    void MyCobot::OnMotionCommandSent()
     {
-        // 요청 순서를 정하여 통신 과부하를 막습니다.
-        int request_type = m_polling_counter % 3; // 0, 1, 2 반복
+        const auto now = std::chrono::steady_clock::now();
+        const bool was_idle = m_motion_polling->CurrentState(now) == MotionPollingPolicy::State::Idle;
+        m_motion_polling->OnMotionCommand(now);
+        PublishState(); // 다른 스레드의 PeekAnglesAt 등이 새 명령 목표를 보도록
+        if (was_idle && m_polling_timer.isActive())
+        {
+            // 남은 heartbeat를 기다리지 않고 바로 한 틱을 돌린 뒤 기본 틱으로 다시 시작합니다.
+            pollNextData();
+            m_polling_timer.start();
+        }
+    }
 
-        switch (request_type)
+    void MyCobot::SetPollingPlan(const std::vector<PollingEntry> &plan)
+    {
+        m_polling_plan = plan;
+        CompilePollingPlan();
+        if (m_polling_timer.isActive())
         {
-        case 0:
-            RequestIsMoving();
-            break;
-        case 1:
-            RequestSpeeds();
-            break;
-        case 2:
-            // 예시: J1 관절의 부하만 주기적으로 요청
-            RequestJointLoad(Joint::J1);
-            break;
-        case 3:
-            RequestAngles();
-            break;
-        default:
-            break;
+            m_polling_timer.setInterval(static_cast<int>(m_polling_schedule->Tick().count()));
         }
-        m_polling_counter++;
+    }
+
+    std::vector<PollingEntry> MyCobot::GetPollingPlan() const
+    {
+        std::vector<PollingEntry> plan;
+        for (const PollingSchedule::Slot &slot : m_polling_schedule->Entries())
+        {
+            plan.push_back(slot.entry);
+        }
+        return plan;
     }
 
     /**
-     * @brief [최종] 데이터 요청을 스케줄러(큐)에 등록합니다. (비동기)
+     * @brief 현재 폴링 계획을 스케줄로 컴파일합니다.
+     * 사용자 계획이 없으면 예전 라운드 로빈(IsMoving, Speeds, J1 부하를 한 틱씩)과 같은 계획을 씁니다.
      */
-    void MyCobot::scheduleRequest(RequestType request_type, Joint joint)
+    void MyCobot::CompilePollingPlan()
     {
-        // 1. 요청을 대기열(큐)에 추가합니다.
-        m_request_queue.push({request_type, joint});
-
-        // 2. 지금 바로 다음 요청을 처리할 수 있는지 확인합니다.
-        processNextRequestInQueue();
+        std::vector<PollingEntry> plan = m_polling_plan;
+        if (plan.empty())
+        {
+            const double rate_hz = 1000.0 / (3.0 * m_polling_interval_ms);
+            plan = {{RequestType::REQ_IsMoving, Joint::J1, rate_hz},
+                    {RequestType::REQ_Speeds, Joint::J1, rate_hz},
+                    {RequestType::REQ_Loads, Joint::J1, rate_hz}};
+        }
+        m_polling_schedule->Compile(plan, std::chrono::milliseconds{m_polling_interval_ms}, m_baud_rate,
+                                    m_poll_rate->TargetUtilization());
+        m_polling_counter = 0;
+        if (m_polling_schedule->Degraded())
+        {
+            LogWarn << "Polling plan exceeds the link budget; low-priority rates were reduced (estimated utilization "
+                       << m_polling_schedule->EstimatedUtilization() << ").";
+        }
     }
 
     /**
-     * @brief [private slot] 큐를 확인하고, 가능하면 다음 요청을 보냅니다.
+     * @brief [private slot] 자동 폴링 타이머에 의해 주기적으로 호출됩니다.
+     * 폴링 계획의 주파수에 맞춰 틱마다 정해진 요청만 보내 통신 과부하를 방지합니다.
      */
-    void MyCobot::processNextRequestInQueue()
+    void MyCobot::pollNextData()
     {
-        // 관제탑이 바쁘거나(다른 요청 처리 중) 대기 중인 요청이 없으면 아무것도 하지 않습니다.
-        if (m_scheduler_is_busy || m_request_queue.empty())
+        const auto now = std::chrono::steady_clock::now();
+        auto interval = m_polling_schedule->Tick();
+        if (m_adaptive_polling)
         {
-            return;
+            // 직전 틱의 트래픽과 왕복 지연으로 다음 틱 간격을 정합니다. staleness budget보다 길어지지 않습니다.
+            const auto period = m_poll_rate->Update(now, m_pipeline->Window());
+            interval = PollingSchedule::AdaptiveTick(period, m_poll_rate->StalenessBudget());
+        }
+        // 로봇이 멈춰 있으면 틱을 heartbeat까지 늘리고, 움직임을 알아챌 수 있도록 IsMoving은 매 틱 요청합니다.
+        interval = m_motion_polling->NextInterval(interval, now);
+        if (m_motion_polling->CurrentState(now) == MotionPollingPolicy::State::Idle)
+        {
+            scheduleRequest(RequestType::REQ_IsMoving);
+        }
+        if (m_polling_timer.interval() != static_cast<int>(interval.count()))
+        {
+            m_polling_timer.setInterval(static_cast<int>(interval.count()));
         }
 
-        // 관제탑을 '바쁨' 상태로 만들고, 큐에서 다음 요청을 꺼냅니다.
-        m_scheduler_is_busy = true;
-        auto request = m_request_queue.front();
-        m_request_queue.pop();
+        // 컴파일된 스케줄에서 이번 틱에 보낼 요청만 등록합니다.
+        // 스케줄러를 거치므로 응답이 밀려도 같은 요청이 쌓이지 않습니다.
+        m_polling_schedule->ForEachDue(m_polling_counter, [this](const PollingEntry &entry)
+                                       { scheduleRequest(entry.type, entry.joint); });
+        m_polling_counter++;
+    }
 
-        RequestType type = request.first;
-        Joint joint = request.second;
+    /**
+     * @brief [최종] 데이터 요청을 스케줄러(큐)에 등록합니다. (비동기)
+     */
+    bool MyCobot::scheduleRequest(RequestType request_type, Joint joint)
+    {
+        if (request_type == RequestType::REQ_LoadSweep)
+        {
+            RequestLoadSweep();
+            return m_load_sweep_active; // 일부 관절이 거부되면 스윕은 이미 끝났습니다.
+        }
 
-        // 요청 타입에 따라 적절한 명령어를 로봇에게 보냅니다.
-        switch (type)
+        // 1. 요청을 대기열(큐)에 추가합니다. 같은 요청이 대기 중이면 합쳐집니다.
+        const EnqueueResult result = m_pipeline->Enqueue(request_type, joint);
+        if (result == EnqueueResult::Rejected)
         {
-        case RequestType::REQ_Angles:
-            RequestAngles(); // 내부적으로 SerialWrite(CommandGetAngles) 호출
-            break;
-        case RequestType::REQ_Speeds:
-            RequestSpeeds(); // 내부적으로 SerialWrite(...) 호출
-            break;
-        case RequestType::REQ_Loads:
-            RequestJointLoad(joint);
-            break;
-        case RequestType::REQ_Coords:
-            RequestCoords();
-            break;
-        case RequestType::REQ_IsMoving:
-            RequestIsMoving();
-            break;
-        case RequestType::REQ_Voltages:
-            RequestVoltages();
-            break;
-        default:
-            // 처리되지 않은 요청 타입에 대한 처리
-            m_scheduler_is_busy = false; // 스케줄러를 다시 활성화
-            break;
+            LogDebug << "Request queue is full, request rejected (backpressure).";
         }
+
+        // 2. 지금 바로 다음 요청을 처리할 수 있는지 확인합니다.
+        processNextRequestInQueue();
+        return result != EnqueueResult::Rejected;
     }
 
-    // 요청만 보내는 비동기 함수
-    void MyCobot::RequestVoltages()
+    void MyCobot::SetRequestWindow(int window)
     {
-        // 전압 요청 명령어(0xE3) 패킷을 생성하여 전송
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-        command.append(char(2));                           // LEN
-        command.append(char(Command::GET_SERVO_VOLTAGES)); // 0xE3
-        command.append(FIRMATA_FOOTER);
-
-        // 직접 전송 (응답은 나중에 HandleReadyRead가 처리)
-        SerialWrite(command);
+        m_pipeline->SetWindow(window);
+        processNextRequestInQueue();
     }
 
-    void MyCobot::RequestAngles()
+    void MyCobot::SetRequestTimeout(int timeout_ms)
     {
-        SerialWrite(CommandGetAngles);
+        m_pipeline->SetTimeout(std::chrono::milliseconds{timeout_ms});
     }
 
-    void MyCobot::RequestSpeeds()
+    void MyCobot::SetRequestRetries(int max_retries)
     {
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-        command.append(char(2));
-        command.append(char(Command::GET_SERVO_SPEEDS));
-        command.append(FIRMATA_FOOTER);
-        SerialWrite(command);
+        m_pipeline->SetMaxRetries(max_retries);
     }
 
-    void MyCobot::RequestCoords()
+    void MyCobot::SetRequestQueueDepth(int max_depth)
     {
-        // GetCoords 명령어(0x23)는 파라미터가 필요 없습니다.
-        // [HEADER, HEADER, LEN(3), CMD(0x23), FOOTER]
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-        command.append(char(2));                  // LEN
-        command.append(char(Command::GetCoords)); // 0x23
-        command.append(FIRMATA_FOOTER);
-
-        // 직접 전송 (응답은 나중에 HandleReadyRead가 처리)
-        SerialWrite(command);
+        m_pipeline->SetMaxDepth(max_depth);
     }
 
-    /**
-     * @brief [신규] 특정 관절의 부하 데이터 요청을 보냅니다. (비동기)
-     */
-    void MyCobot::RequestJointLoad(Joint joint)
+    RequestStats MyCobot::GetRequestStats() const
     {
-        // 다음에 올 응답이 어떤 관절의 것인지 기억해둡니다.
-        m_last_requested_load_joint = joint;
+        RequestStats stats;
+        stats.queued = m_pipeline->QueuedCount();
+        stats.in_flight = m_pipeline->InFlightCount();
+        stats.completed = m_pipeline->CompletedCount();
+        stats.timed_out = m_pipeline->TimedOutCount();
+        stats.retried = m_pipeline->RetriedCount();
+        stats.dropped = m_pipeline->DroppedCount();
+        stats.merged = m_pipeline->MergedCount();
+        stats.rejected = m_pipeline->RejectedCount();
+        stats.evicted = m_pipeline->EvictedCount();
+        stats.saturated = m_pipeline->IsSaturated();
+        return stats;
+    }
 
-        // GetServoData(0x53) 명령어를 2바이트 읽기 모드로 보냅니다.
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-        command.append(char(5));
-        command.append(char(Command::GetServoData));
-        command.append(static_cast<char>(joint));
-        command.append(char(PRESENT_LOAD_ADDRESS));
-        command.append(static_cast<char>(1)); // 2바이트 읽기 모드
-        command.append(FIRMATA_FOOTER);
-        SerialWrite(command);
+    StreamStats MyCobot::GetStreamStats() const
+    {
+        StreamStats stats;
+        const DecoderStats decoder_stats = m_io_worker ? m_io_worker->GetDecoderStats() : m_decoder->Stats();
+        stats.packets = decoder_stats.packets;
+        stats.resyncs = decoder_stats.resyncs;
+        stats.discarded_bytes = decoder_stats.discarded_bytes;
+        stats.dropped_packets = m_io_worker ? m_io_worker->DroppedPackets() : 0;
+        return stats;
     }
 
-    void MyCobot::RequestIsMoving()
+    LatencyStats MyCobot::GetLatencyStats(unsigned char command) const
     {
-        // CheckRunning 명령어(0x2B) 패킷을 직접 생성하여 전송합니다.
-        // 데이터가 없으므로 길이는 2입니다.
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-        command.append(char(2));
-        command.append(char(Command::CheckRunning));
-        command.append(FIRMATA_FOOTER);
-        SerialWrite(command);
+        LatencyStats stats;
+        stats.command = command;
+        m_latency->Stats(command, stats);
+        return stats;
     }
 
-    // 저장된 값을 보기만 하는 함수
-    Angles MyCobot::PeekAngles() const
+    std::vector<LatencyStats> MyCobot::GetAllLatencyStats() const
     {
-        return cur_angles;
+        return m_latency->AllStats();
     }
 
-    IntAngles MyCobot::PeekSpeeds() const
+    bool MyCobot::StartTelemetryRecording(const std::string &path)
     {
-        return real_cur_speeds;
+        std::string error;
+        if (!m_recorder->Start(path, error))
+        {
+            m_last_error_string = QString::fromStdString(error);
+            LogError << "Could not start telemetry recording: " << m_last_error_string;
+            return false;
+        }
+        LogInfo << "Telemetry recording started: " << QString::fromStdString(path);
+        return true;
     }
 
-    Voltages MyCobot::PeekVoltages() const
+    void MyCobot::StopTelemetryRecording()
     {
-        // 로봇과 통신하지 않고, 현재 캐시된 값을 바로 반환
-        return real_cur_voltages;
+        m_recorder->Stop();
     }
 
-    Coords MyCobot::PeekCoords() const
+    TelemetryRecordingStats MyCobot::GetTelemetryRecordingStats() const
     {
-        // 뮤텍스 등으로 보호할 필요 없이, 현재 캐시된 값을 바로 반환
-        return cur_coords;
+        TelemetryRecordingStats stats;
+        stats.recording = m_recorder->IsRecording();
+        stats.failed = m_recorder->Failed();
+        stats.written = m_recorder->Written();
+        stats.dropped = m_recorder->Dropped();
+        stats.file_size = m_recorder->FileSize();
+        return stats;
     }
 
-    /**
-     * @brief [신규] 특정 관절의 캐시된 부하 값을 조회합니다.
-     */
-    int MyCobot::PeekJointLoad(Joint joint) const
+    bool MyCobot::StartSerialCapture(const std::string &path)
     {
-        // 배열 인덱스는 0부터 시작하므로, joint ID에서 1을 빼줍니다.
-        if (joint >= J1 && joint <= J6)
+        auto capture = std::make_unique<SerialCaptureWriter>();
+        std::string error;
+        if (!capture->Open(path, error))
         {
-            return real_cur_loads[static_cast<int>(joint) - 1];
+            m_last_error_string = QString::fromStdString(error);
+            LogError << "Could not start serial capture: " << m_last_error_string;
+            return false;
         }
-        return -1; // 잘못된 관절 ID
+        m_capture = std::move(capture);
+        LogInfo << "Serial capture started: " << QString::fromStdString(path);
+        return true;
     }
 
-    bool MyCobot::PeekIsMoving() const
+    void MyCobot::StopSerialCapture()
     {
-        return robot_is_moving;
+        if (m_capture)
+        {
+            LogInfo << "Serial capture stopped: " << m_capture->Records() << " records, " << m_capture->Bytes() << " bytes";
+            m_capture.reset();
+        }
     }
 
-    double MyCobot::GetSpeed()
+    void MyCobot::CaptureBytes(bool transmit, const char *data, std::size_t size)
     {
-        // 1. GetSpeed 명령어(0x40)를 직접 보냄
-        // [HEADER, HEADER, LEN(3), CMD(0x40), FOOTER]
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-        command.append(char(2));                 // LEN
-        command.append(char(Command::GetSpeed)); // 0x40
-        command.append(FIRMATA_FOOTER);
-        SerialWrite(command);
-
-        // 2. 응답이 올 때까지 이벤트 루프를 돌며 대기 (동기화)
-        QEventLoop loop;
-        QTimer timer;
-        timer.setSingleShot(true);
-
-        // HandleReadyRead의 case Command::GetSpeed: 에서 이 시그널을 emit 해야 함
-        connect(this, &MyCobot::speedReceived, &loop, &QEventLoop::quit); // 가상의 시그널
-        connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
-
-        timer.start(SERIAL_TIMEOUT);
-        loop.exec();
-
-        // 3. HandleReadyRead에 의해 업데이트된 최신 속도 값을 반환
-        return cur_speed;
+        if (m_capture && !m_capture->Write(transmit ? CaptureDirection::Tx : CaptureDirection::Rx, data, size,
+                                           std::chrono::steady_clock::now()))
+        {
+            LogError << "Serial capture write failed, capture stopped.";
+            m_capture.reset();
+        }
     }
 
-    bool MyCobot::IsInPosition(const Coords &coords, bool is_linear)
+    ReplayStats MyCobot::ReplaySerialCapture(const std::string &path, double speed)
     {
-        // 응답 수신 여부를 확인하기 위한 플래그
-        bool response_received = false;
+        ReplayStats stats;
+        // 재생 중 이벤트 루프가 도는 동안 실제 수신 바이트와 응답이 섞이지 않도록, 포트가 닫혀 있을 때만 재생합니다.
+        if (IsCncConnected() || m_polling_timer.isActive())
+        {
+            stats.error = "Cannot replay a serial capture while the port is open or auto-polling is running.";
+            m_last_error_string = QString::fromStdString(stats.error);
+            LogError << m_last_error_string;
+            return stats;
+        }
+        SerialCaptureReader reader;
+        if (!reader.Open(path, stats.error))
+        {
+            m_last_error_string = QString::fromStdString(stats.error);
+            LogError << "Could not replay serial capture: " << m_last_error_string;
+            return stats;
+        }
 
-        // 1. 전체 로직을 try-catch로 감쌉니다.
+        // 연결 중에 남은 바이트가 재생한 패킷과 섞이지 않도록 디코더를 비우고, 응답은 캡처된 송신 프레임과 짝짓습니다.
+        m_decoder->Clear();
+        m_replay_pipeline = std::make_unique<RequestPipeline>();
+        m_replay_pipeline->SetTimeout(m_pipeline->Timeout());
+        m_replay_pipeline->SetMaxRetries(0);
+
+        const auto started = std::chrono::steady_clock::now();
+        SerialCaptureReader::Record record;
+        int64_t first_ns = -1;
         try
         {
-            // IsInPosition 명령어(0x2A) 패킷 생성
-            QByteArray command;
-            command.append(FIRMATA_HEADER);
-            // LEN 계산: Coords(12) + is_linear(1) + CMD(1) + 자기자신(1) = 15
-            command.append(char(15));
-            command.append(char(Command::IsInPosition)); // 0x2A
-
-            // 파라미터 직렬화
-            if (is_linear)
+            while (reader.Next(record))
             {
-                for (int i = 0; i < 3; ++i)
+                if (first_ns < 0)
                 {
-                    signed short tenth_mm = static_cast<signed short>(coords[i] * 10);
-                    command += static_cast<char>(tenth_mm >> 8);
-                    command += static_cast<char>(tenth_mm & 0x00FF);
+                    first_ns = record.offset_ns;
                 }
-                for (int i = 3; i < rc::Axes; ++i)
+                stats.captured = std::chrono::nanoseconds(record.offset_ns - first_ns);
+
+                if (speed > 0.0)
                 {
-                    signed short centi_deg = static_cast<signed short>(coords[i] * 100);
-                    command += static_cast<char>(centi_deg >> 8);
-                    command += static_cast<char>(centi_deg & 0x00FF);
+                    // 기록된 간격을 지키며 이벤트 루프를 돌립니다. 1ms 미만의 간격은 기다리지 않습니다.
+                    const auto due = started + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                   std::chrono::duration<double, std::nano>(static_cast<double>(stats.captured.count()) / speed));
+                    const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(due - std::chrono::steady_clock::now());
+                    if (remaining.count() > 0)
+                    {
+                        QEventLoop loop;
+                        QTimer::singleShot(static_cast<int>(remaining.count()), &loop, &QEventLoop::quit);
+                        loop.exec();
+                    }
                 }
+
+                // 응답이 오지 않은 요청은 캡처 시각 기준으로 타임아웃시켜 뒤의 응답과 짝지어지지 않게 합니다.
+                const auto captured_at = std::chrono::steady_clock::time_point{} +
+                                         std::chrono::duration_cast<std::chrono::steady_clock::duration>(stats.captured);
+                m_replay_pipeline->ExpireTimedOut(captured_at);
+                m_replay_captured_at = captured_at;
+
+                if (record.direction == CaptureDirection::Tx)
+                {
+                    // 송신 프레임은 다시 보내지 않고, 응답과 짝지을 요청으로 등록합니다. [FE FE LEN CMD ...]
+                    // 지연 통계(GetLatencyStats)는 실제 통신만 반영하므로 건드리지 않습니다.
+                    if (record.data.size() >= 4)
+                    {
+                        const auto command = static_cast<unsigned char>(record.data[3]);
+                        // GetServoData 응답에는 관절 번호가 없으므로 송신 프레임에서 읽습니다. [FE FE LEN CMD joint addr ... FA]
+                        // 부하 주소가 아닌 읽기(동기 GetServoData)는 관절 0으로 두어 부하 값으로 반영하지 않습니다.
+                        Joint joint = Joint::J1;
+                        if (command == Command::GetServoData)
+                        {
+                            const bool is_load = record.data.size() >= 6 && static_cast<unsigned char>(record.data[5]) == PRESENT_LOAD_ADDRESS;
+                            joint = static_cast<Joint>(is_load ? static_cast<unsigned char>(record.data[4]) : 0);
+                        }
+                        m_replay_pipeline->TrackReplayed(command, joint, captured_at);
+                    }
+                    ++stats.tx_frames;
+                    continue;
+                }
+                ++stats.rx_chunks;
+                stats.rx_bytes += record.data.size();
+                stats.packets += FeedReceivedBytes(record.data.data(), record.data.size());
+                EmitChangeNotifications();
             }
-            else
+        }
+        catch (...)
+        {
+            m_replay_pipeline.reset();
+            m_decoder->Clear();
+            throw;
+        }
+        m_replay_pipeline.reset();
+        m_decoder->Clear();
+        stats.elapsed = std::chrono::steady_clock::now() - started;
+        stats.ok = true;
+        return stats;
+    }
+
+    void MyCobot::ResetLatencyStats()
+    {
+        m_latency->Reset();
+    }
+
+    /**
+     * @brief [private slot] window에 여유가 있는 만큼 대기열의 요청을 보냅니다.
+     */
+    void MyCobot::processNextRequestInQueue()
+    {
+        PendingRequest request;
+        while (m_pipeline->Dispatch(std::chrono::steady_clock::now(), request))
+        {
+            try
             {
-                for (const double &angle : coords)
+                // 요청 타입에 따라 적절한 명령어를 로봇에게 보냅니다.
+                switch (request.type)
+                {
+                case RequestType::REQ_Angles:
+                    RequestAngles(); // 내부적으로 SerialWrite(CommandGetAngles) 호출
+                    break;
+                case RequestType::REQ_Speeds:
+                    RequestSpeeds(); // 내부적으로 SerialWrite(...) 호출
+                    break;
+                case RequestType::REQ_Loads:
+                    // GetServoData(0x53) 명령어를 2바이트 읽기 모드(1)로 보냅니다.
+                    SerialWrite(frames::GetServoData16::Encode(request.joint, PRESENT_LOAD_ADDRESS, 1));
+                    break;
+                case RequestType::REQ_Coords:
+                    RequestCoords();
+                    break;
+                case RequestType::REQ_IsMoving:
+                    RequestIsMoving();
+                    break;
+                case RequestType::REQ_Voltages:
+                    RequestVoltages();
+                    break;
+                case RequestType::REQ_Encoders:
+                    SerialWrite(frames::GetEncoders::Encode());
+                    break;
+                case RequestType::REQ_Speed:
+                    SerialWrite(frames::GetSpeed::Encode());
+                    break;
+                case RequestType::REQ_IsPowerOn:
+                    SerialWrite(frames::IsPoweredOn::Encode());
+                    break;
+                case RequestType::REQ_IsProgramPaused:
+                    SerialWrite(frames::IsProgramPaused::Encode());
+                    break;
+                case RequestType::REQ_IsInPosition:
                 {
-                    signed short centi_deg = static_cast<signed short>(angle * 100);
-                    command += static_cast<char>(centi_deg >> 8);
-                    command += static_cast<char>(centi_deg & 0x00FF);
+                    // 목표 좌표/각도는 조회에 함께 저장되어 있습니다.
+                    const auto query = m_queries.find(request.query_id);
+                    if (query == m_queries.end())
+                    {
+                        m_pipeline->CancelLastDispatch();
+                    }
+                    else if (query->second.is_linear)
+                    {
+                        SerialWrite(frames::IsInPositionCoords::Encode(query->second.coords, 1));
+                    }
+                    else
+                    {
+                        SerialWrite(frames::IsInPositionAngles::Encode(query->second.coords, 0));
+                    }
+                    break;
+                }
+                case RequestType::REQ_IsServoEnabled:
+                    SerialWrite(frames::IsServoEnabled::Encode(request.joint));
+                    break;
+                case RequestType::REQ_IsAllServoEnabled:
+                    SerialWrite(frames::IsAllServoEnabled::Encode());
+                    break;
+                case RequestType::REQ_LoadSweep: // scheduleRequest()에서 펼쳐지므로 대기열에 들어오지 않습니다.
+                default:
+                    // 처리되지 않은 요청 타입은 응답을 기다리지 않습니다.
+                    m_pipeline->CancelLastDispatch();
+                    break;
                 }
             }
-            command.append(static_cast<char>(is_linear));
-            command.append(FIRMATA_FOOTER);
+            catch (...)
+            {
+                // 보내지 못한 요청은 in-flight에서 빼고 예외를 그대로 전달합니다.
+                m_pipeline->CancelLastDispatch();
+                if (request.query_id != 0)
+                {
+                    FinishQuery(request.query_id, "Failed to send query: serial write failed.");
+                }
+                ArmRequestTimer();
+                throw;
+            }
+        }
+        ArmRequestTimer();
+    }
+
+    /**
+     * @brief 가장 이른 in-flight deadline에 맞춰 타임아웃 타이머를 다시 설정합니다.
+     */
+    void MyCobot::ArmRequestTimer()
+    {
+        std::chrono::steady_clock::time_point deadline;
+        if (!m_pipeline->NextDeadline(deadline))
+        {
+            m_request_timer.stop();
+            return;
+        }
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        m_request_timer.start(std::max(0, static_cast<int>(remaining.count()) + 1));
+    }
+
+    /**
+     * @brief [private slot] 응답이 오지 않은 요청을 정리하고 다음 요청을 보냅니다.
+     */
+    void MyCobot::HandleRequestTimeout()
+    {
+        std::vector<PendingRequest> dropped;
+        const uint64_t resyncs = m_pipeline->ResyncCount();
+        const std::size_t expired = m_pipeline->ExpireTimedOut(std::chrono::steady_clock::now(), &dropped);
+        if (expired > 0)
+        {
+            LogDebug << expired << " request(s) timed out without response (" << dropped.size() << " dropped).";
+        }
+        // 부하 요청이 타임아웃되면 늦은 응답이 어느 관절의 것인지 알 수 없으므로, 진행 중인 스윕은 완성으로 치지 않습니다.
+        if (m_pipeline->ResyncCount() != resyncs && m_load_sweep_active)
+        {
+            AbandonLoadSweep();
+        }
+        // 재시도 없이 버려진 비동기 조회는 타임아웃으로 끝냅니다.
+        for (const PendingRequest &request : dropped)
+        {
+            if (request.query_id != 0)
+            {
+                FinishQuery(request.query_id, "Timeout: No response received for query.");
+            }
+        }
+        processNextRequestInQueue();
+    }
+
+    // 요청만 보내는 비동기 함수
+    void MyCobot::RequestVoltages()
+    {
+        // 전압 요청 명령어(0xE3)를 직접 전송 (응답은 나중에 HandleReadyRead가 처리)
+        SerialWrite(frames::GetServoVoltages::Encode());
+    }
+
+    void MyCobot::RequestAngles()
+    {
+        SerialWrite(frames::GetAngles::Encode());
+    }
+
+    void MyCobot::RequestSpeeds()
+    {
+        SerialWrite(frames::GetServoSpeeds::Encode());
+    }
+
+    void MyCobot::RequestCoords()
+    {
+        // GetCoords 명령어(0x23)는 파라미터가 필요 없습니다.
+        // [HEADER, HEADER, LEN(2), CMD(0x23), FOOTER]
+        // 직접 전송 (응답은 나중에 HandleReadyRead가 처리)
+        SerialWrite(frames::GetCoords::Encode());
+    }
+
+    /**
+     * @brief [신규] 특정 관절의 부하 데이터 요청을 보냅니다. (비동기)
+     */
+    void MyCobot::RequestJointLoad(Joint joint)
+    {
+        // 응답에 관절 번호가 없으므로 직접 보내지 않고 스케줄러를 거칩니다. (응답을 요청과 짝짓기 위해)
+        scheduleRequest(RequestType::REQ_Loads, joint);
+    }
+
+    /**
+     * @brief J1~J6 부하 요청을 대기열에 넣고 새 스윕을 시작합니다. (비동기)
+     * GetServoData 응답에는 관절 번호가 없으므로 파이프라인은 한 번에 한 관절만 보내고, 응답이 오면 다음 관절을 보냅니다.
+     * 그래서 응답은 항상 유일한 in-flight 요청의 관절과 짝지어집니다.
+     */
+    void MyCobot::RequestLoadSweep()
+    {
+        if (m_load_sweep_active)
+        {
+            // 이전 스윕의 응답 일부가 오지 않았습니다 (타임아웃 후 버려짐 등).
+            AbandonLoadSweep();
+        }
+        m_load_sweep_values = {};
+        m_load_sweep_mask = 0;
+        m_load_sweep_active = true;
+        m_load_sweep.started_at = std::chrono::steady_clock::now();
+        PublishState();
+
+        for (int joint = J1; joint <= J6; ++joint)
+        {
+            if (m_pipeline->Enqueue(RequestType::REQ_Loads, static_cast<Joint>(joint)) == EnqueueResult::Rejected)
+            {
+                // 한 관절이라도 대기열에 넣지 못하면 이 스윕은 완성될 수 없으므로 바로 끝냅니다.
+                // 이미 넣은 요청은 그대로 보내져 관절별 부하 캐시만 갱신합니다.
+                LogDebug << "Request queue is full, load sweep abandoned at J" << joint << " (backpressure).";
+                AbandonLoadSweep();
+                break;
+            }
+        }
+        processNextRequestInQueue();
+    }
 
-            // 명령어 전송
-            SerialWrite(command);
+    void MyCobot::AbandonLoadSweep()
+    {
+        ++m_load_sweep.abandoned;
+        m_load_sweep_values = {};
+        m_load_sweep_mask = 0;
+        m_load_sweep_active = false;
+        PublishState();
+    }
+
+    void MyCobot::RequestIsMoving()
+    {
+        // CheckRunning 명령어(0x2B)를 직접 전송합니다. 데이터가 없으므로 길이는 2입니다.
+        SerialWrite(frames::CheckRunning::Encode());
+    }
+
+    bool MyCobot::OnOwnerThread() const
+    {
+        return QThread::currentThread() == thread();
+    }
+
+    RobotState MyCobot::CollectState() const
+    {
+        RobotState state;
+        state.angles = MakeSample(cur_angles, m_angles_info);
+        state.coords = MakeSample(cur_coords, m_coords_info);
+        state.encoders = MakeSample(cur_encoders, m_encoders_info);
+        state.speeds = MakeSample(real_cur_speeds, m_speeds_info);
+        state.voltages = MakeSample(real_cur_voltages, m_voltages_info);
+        for (std::size_t i = 0; i < Joints; ++i)
+        {
+            state.loads[i] = MakeSample(real_cur_loads[i], m_load_info[i]);
+        }
+        state.is_moving = MakeSample(robot_is_moving, m_is_moving_info);
+        state.joint_motion = MakeSample(m_angle_estimator->State(), m_joint_motion_info);
+        state.encoder_motion = MakeSample(m_encoder_estimator->State(), m_encoder_motion_info);
+        state.coord_motion = MakeSample(m_coord_estimator->State(), m_coord_motion_info);
+        state.angle_command = m_angle_command;
+        state.coord_command = m_coord_command;
+        state.load_sweep = m_load_sweep;
+        state.speed = cur_speed;
+        state.is_powered_on = is_powered_on;
+        state.is_program_paused = is_program_paused;
+        state.is_in_position = is_in_position;
+        state.is_all_servo_enabled = is_all_servo_enabled;
+        std::copy(std::begin(servo_enabled), std::end(servo_enabled), state.servo_enabled.begin());
+        return state;
+    }
+
+    void MyCobot::PublishState()
+    {
+        m_state_snapshot->Store(CollectState());
+    }
+
+    // 저장된 값을 보기만 하는 함수
+    // 캐시를 쓰는 스레드에서는 캐시를 바로 읽으므로, 시그널 슬롯 안에서도 방금 받은 값이 보입니다.
+    // 다른 스레드에서는 seqlock 스냅샷을 읽습니다.
+    RobotState MyCobot::PeekState() const
+    {
+        return OnOwnerThread() ? CollectState() : m_state_snapshot->Load();
+    }
+
+    Angles MyCobot::PeekAngles() const
+    {
+        return PeekAnglesSample().value;
+    }
+
+    IntAngles MyCobot::PeekSpeeds() const
+    {
+        return PeekSpeedsSample().value;
+    }
+
+    Voltages MyCobot::PeekVoltages() const
+    {
+        // 로봇과 통신하지 않고, 현재 캐시된 값을 바로 반환
+        return PeekVoltagesSample().value;
+    }
+
+    Coords MyCobot::PeekCoords() const
+    {
+        return PeekCoordsSample().value;
+    }
+
+    Angles MyCobot::PeekEncoders() const
+    {
+        return PeekEncodersSample().value;
+    }
+
+    LoadSweep MyCobot::PeekLoadSweep() const
+    {
+        return OnOwnerThread() ? m_load_sweep : m_state_snapshot->Load().load_sweep;
+    }
+
+    /**
+     * @brief [신규] 특정 관절의 캐시된 부하 값을 조회합니다.
+     */
+    int MyCobot::PeekJointLoad(Joint joint) const
+    {
+        return PeekJointLoadSample(joint).value;
+    }
+
+    bool MyCobot::PeekIsMoving() const
+    {
+        return PeekIsMovingSample().value;
+    }
+
+    Sample<Angles> MyCobot::PeekAnglesSample() const
+    {
+        return OnOwnerThread() ? MakeSample(cur_angles, m_angles_info) : m_state_snapshot->Load().angles;
+    }
+
+    Sample<Coords> MyCobot::PeekCoordsSample() const
+    {
+        return OnOwnerThread() ? MakeSample(cur_coords, m_coords_info) : m_state_snapshot->Load().coords;
+    }
+
+    Sample<Angles> MyCobot::PeekEncodersSample() const
+    {
+        return OnOwnerThread() ? MakeSample(cur_encoders, m_encoders_info) : m_state_snapshot->Load().encoders;
+    }
+
+    Sample<IntAngles> MyCobot::PeekSpeedsSample() const
+    {
+        return OnOwnerThread() ? MakeSample(real_cur_speeds, m_speeds_info) : m_state_snapshot->Load().speeds;
+    }
+
+    Sample<Voltages> MyCobot::PeekVoltagesSample() const
+    {
+        return OnOwnerThread() ? MakeSample(real_cur_voltages, m_voltages_info) : m_state_snapshot->Load().voltages;
+    }
+
+    Sample<int> MyCobot::PeekJointLoadSample(Joint joint) const
+    {
+        // 배열 인덱스는 0부터 시작하므로, joint ID에서 1을 빼줍니다.
+        if (joint >= J1 && joint <= J6)
+        {
+            const auto index = static_cast<std::size_t>(joint) - 1;
+            return OnOwnerThread() ? MakeSample(real_cur_loads[index], m_load_info[index]) : m_state_snapshot->Load().loads[index];
+        }
+        return MakeSample(-1, SampleInfo{}); // 잘못된 관절 ID
+    }
+
+    Sample<bool> MyCobot::PeekIsMovingSample() const
+    {
+        return OnOwnerThread() ? MakeSample(robot_is_moving, m_is_moving_info) : m_state_snapshot->Load().is_moving;
+    }
+
+    Sample<JointMotion> MyCobot::PeekJointMotion() const
+    {
+        return OnOwnerThread() ? MakeSample(m_angle_estimator->State(), m_joint_motion_info) : m_state_snapshot->Load().joint_motion;
+    }
+
+    Sample<JointMotion> MyCobot::PeekEncoderMotion() const
+    {
+        return OnOwnerThread() ? MakeSample(m_encoder_estimator->State(), m_encoder_motion_info) : m_state_snapshot->Load().encoder_motion;
+    }
+
+    void MyCobot::SetMotionEstimator(int time_constant_ms, int max_gap_ms)
+    {
+        for (MotionEstimator *estimator : {m_angle_estimator.get(), m_encoder_estimator.get(), m_coord_estimator.get()})
+        {
+            estimator->SetTimeConstant(std::chrono::milliseconds(time_constant_ms));
+            estimator->SetMaxGap(std::chrono::milliseconds(max_gap_ms));
+        }
+    }
+
+    void MyCobot::UpdateMotionEstimate(MotionEstimator &estimator, SampleInfo &motion_info, const Angles &measured, const SampleInfo &info)
+    {
+        // 로봇이 값을 읽은 시각은 알 수 없으므로 요청과 응답의 중간으로 봅니다.
+        const auto measured_at = info.sent_at + (info.received_at - info.sent_at) / 2;
+        if (estimator.Update(measured, measured_at))
+        {
+            motion_info.sent_at = info.sent_at;
+            motion_info.received_at = info.received_at;
+            ++motion_info.sequence;
+        }
+    }
+
+    Estimate<Angles> MyCobot::PeekAnglesAt(std::chrono::steady_clock::time_point time) const
+    {
+        const RobotState state = PeekState();
+        return PredictState(m_history->angles, state.joint_motion, state.angle_command, time,
+                            std::chrono::milliseconds(m_prediction_horizon_ms.load(std::memory_order_relaxed)), 0);
+    }
+
+    Estimate<Coords> MyCobot::PeekCoordsAt(std::chrono::steady_clock::time_point time) const
+    {
+        const RobotState state = PeekState();
+        return PredictState(m_history->coords, state.coord_motion, state.coord_command, time,
+                            std::chrono::milliseconds(m_prediction_horizon_ms.load(std::memory_order_relaxed)),
+                            m_coord_estimator->WrapMask());
+    }
+
+    void MyCobot::SetPredictionHorizon(int max_extrapolation_ms)
+    {
+        m_prediction_horizon_ms.store(std::max(max_extrapolation_ms, 0), std::memory_order_relaxed);
+    }
+
+    const TelemetryHistory &MyCobot::History() const
+    {
+        return *m_history;
+    }
+
+    void MyCobot::SetChangeNotification(TelemetryChannel channel, bool enabled)
+    {
+        SetChangeNotification(channel, enabled, ChangeFilter::DefaultDeadband(channel));
+    }
+
+    void MyCobot::SetChangeNotification(TelemetryChannel channel, bool enabled, double deadband)
+    {
+        m_change_filter->SetEnabled(channel, enabled, deadband);
+    }
+
+    /**
+     * @brief 이번 수신 배치에서 deadband를 넘게 바뀐 채널을 알립니다. 채널별로 한 번, 마지막 값으로 보냅니다.
+     */
+    void MyCobot::EmitChangeNotifications()
+    {
+        const uint32_t changed = m_change_filter->TakePending();
+        if (changed == 0)
+        {
+            return;
+        }
+        const auto has = [changed](TelemetryChannel channel)
+        { return (changed & (1u << static_cast<unsigned>(channel))) != 0; };
+
+        if (has(TelemetryChannel::CH_Angles))
+        {
+            emit anglesChanged(cur_angles);
+        }
+        if (has(TelemetryChannel::CH_Coords))
+        {
+            emit coordsChanged(cur_coords);
+        }
+        if (has(TelemetryChannel::CH_Encoders))
+        {
+            emit encodersChanged(cur_encoders);
+        }
+        if (has(TelemetryChannel::CH_Speeds))
+        {
+            emit speedsChanged(real_cur_speeds);
+        }
+        if (has(TelemetryChannel::CH_Voltages))
+        {
+            emit voltagesChanged(real_cur_voltages);
+        }
+        const unsigned changed_joints = (changed >> static_cast<unsigned>(TelemetryChannel::CH_LoadJ1)) & ((1u << Joints) - 1);
+        if (changed_joints != 0)
+        {
+            emit jointLoadsChanged(real_cur_loads, changed_joints);
+        }
+        if (has(TelemetryChannel::CH_IsMoving))
+        {
+            emit movingChanged(robot_is_moving);
+        }
+        emit stateChanged(changed);
+    }
+
+    double MyCobot::GetSpeed()
+    {
+        // 1. GetSpeed 명령어(0x40)를 직접 보냄
+        // [HEADER, HEADER, LEN(2), CMD(0x40), FOOTER]
+        SerialWrite(frames::GetSpeed::Encode());
+
+        // 2. 응답이 올 때까지 이벤트 루프를 돌며 대기 (동기화)
+        QEventLoop loop;
+        QTimer timer;
+        timer.setSingleShot(true);
+
+        // HandleReadyRead의 case Command::GetSpeed: 에서 이 시그널을 emit 해야 함
+        connect(this, &MyCobot::speedReceived, &loop, &QEventLoop::quit); // 가상의 시그널
+        connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
+
+        timer.start(SERIAL_TIMEOUT);
+        loop.exec();
+
+        // 3. HandleReadyRead에 의해 업데이트된 최신 속도 값을 반환
+        return cur_speed;
+    }
+
+    bool MyCobot::IsInPosition(const Coords &coords, bool is_linear)
+    {
+        // 응답 수신 여부를 확인하기 위한 플래그
+        bool response_received = false;
+
+        // 1. 전체 로직을 try-catch로 감쌉니다.
+        try
+        {
+            // IsInPosition 명령어(0x2A) 전송
+            // [HEADER, HEADER, LEN(15), CMD(0x2A), 좌표 또는 각도(12), is_linear, FOOTER]
+            if (is_linear)
+            {
+                SerialWrite(frames::IsInPositionCoords::Encode(coords, 1));
+            }
+            else
+            {
+                SerialWrite(frames::IsInPositionAngles::Encode(coords, 0));
+            }
 
             // 응답이 올 때까지 이벤트 루프를 돌며 대기
             QEventLoop loop;
@@ -781,34 +1443,50 @@ namespace rc
     // 이 함수는 '안전한 동기' 방식으로 동작하며, GetJointLoad에서 사용됩니다.
     int MyCobot::GetServoData(Joint joint, int data_id, int mode)
     {
+        constexpr int TimeoutMs = 1000;
+        constexpr int SlotPollMs = 2;
+        QElapsedTimer elapsed;
+        elapsed.start();
+        // 응답은 관절 번호 없이 오므로, 다른 GetServoData가 in-flight이면 어느 응답이 이 요청의 것인지 알 수 없습니다.
+        // 폴링의 부하 요청이 끝날 때까지 (재동기화 구간 포함) 이벤트 루프를 돌며 기다린 뒤 in-flight로 등록합니다.
+        // 등록해 두면 그동안 스케줄러는 부하 요청을 보내지 않습니다.
+        while (!m_pipeline->TrackExternal(RequestType::REQ_Loads, joint, std::chrono::steady_clock::now(),
+                                          std::chrono::milliseconds{TimeoutMs - elapsed.elapsed()}))
+        {
+            if (elapsed.elapsed() >= TimeoutMs)
+            {
+                // 타임아웃과 같이 마지막으로 받은 값을 반환합니다.
+                LogWarn << "GetServoData: timed out waiting for in-flight load requests to finish.";
+                return last_servo_data_value;
+            }
+            QEventLoop wait_loop;
+            QTimer::singleShot(SlotPollMs, &wait_loop, &QEventLoop::quit);
+            wait_loop.exec();
+        }
+
         QEventLoop loop;
-        // GetServoData는 이제 GetJointLoad에서만 사용되므로,
-        // 전용 시그널 대신 범용 servoDataReceived를 사용합니다.
+        // servoDataReceived는 이 요청과 짝지어진 응답에만 발생합니다.
         connect(this, &MyCobot::servoDataReceived, &loop, &QEventLoop::quit);
 
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-
-        if (mode == 1)
-        { // 2바이트 읽기
-            command.append(char(5));
-            command.append(char(Command::GetServoData));
-            command.append(static_cast<char>(joint));
-            command.append(static_cast<char>(data_id));
-            command.append(static_cast<char>(mode));
+        try
+        {
+            if (mode == 1)
+            { // 2바이트 읽기
+                SerialWrite(frames::GetServoData16::Encode(joint, data_id, mode));
+            }
+            else
+            { // 1바이트 읽기
+                SerialWrite(frames::GetServoData::Encode(joint, data_id));
+            }
         }
-        else
-        { // 1바이트 읽기
-            command.append(char(4));
-            command.append(char(Command::GetServoData));
-            command.append(static_cast<char>(joint));
-            command.append(static_cast<char>(data_id));
+        catch (...)
+        {
+            m_pipeline->CancelLastDispatch();
+            throw;
         }
+        ArmRequestTimer();
 
-        command.append(FIRMATA_FOOTER);
-        SerialWrite(command);
-
-        QTimer::singleShot(1000, &loop, &QEventLoop::quit);
+        QTimer::singleShot(static_cast<int>(std::max<qint64>(TimeoutMs - elapsed.elapsed(), 0)), &loop, &QEventLoop::quit);
         loop.exec();
 
         return last_servo_data_value;
@@ -824,13 +1502,8 @@ namespace rc
         // ★★★ 1. 전체 로직을 try-catch로 감쌉니다. ★★★
         try
         {
-            // IsProgramPaused 명령어(0x27)를 직접 보냄
-            QByteArray command;
-            command.append(FIRMATA_HEADER);
-            command.append(char(3));                        // LEN: CMD(1) + 자기자신(1) = 2. -> 프로토콜에 따라 3
-            command.append(char(Command::IsProgramPaused)); // 0x27
-            command.append(FIRMATA_FOOTER);
-            SerialWrite(command);
+            // IsProgramPaused 명령어(0x27)를 직접 보냄. LEN: CMD(1) + 자기자신(1) = 2
+            SerialWrite(frames::IsProgramPaused::Encode());
 
             // 응답이 올 때까지 이벤트 루프를 돌며 대기
             QEventLoop loop;
@@ -872,13 +1545,8 @@ namespace rc
         // 1. 전체 로직을 try-catch로 감쌉니다.
         try
         {
-            // IsPoweredOn 명령어(0x12)를 직접 보냄
-            QByteArray command;
-            command.append(FIRMATA_HEADER);
-            command.append(char(3));                    // LEN: CMD(1) + 자기자신(1) = 2. -> 프로토콜에 따라 3
-            command.append(char(Command::IsPoweredOn)); // 0x12
-            command.append(FIRMATA_FOOTER);
-            SerialWrite(command);
+            // IsPoweredOn 명령어(0x12)를 직접 보냄. LEN: CMD(1) + 자기자신(1) = 2
+            SerialWrite(frames::IsPoweredOn::Encode());
 
             // 응답이 올 때까지 이벤트 루프를 돌며 대기
             QEventLoop loop;
@@ -914,120 +1582,356 @@ namespace rc
 
     bool MyCobot::IsServoEnabled(Joint j)
     {
-        // 1. IsServoEnabled 명령어(0x50) 패킷을 직접 생성하여 전송
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-        command.append(char(3));                       // LEN
-        command.append(char(Command::IsServoEnabled)); // 0x50
-
+        // 1. IsServoEnabled 명령어(0x50)를 직접 전송
         // 파라미터로 관절 ID 추가 (원본 코드의 j+1 로직은 펌웨어 규칙에 따라 확인 필요)
-        command.append(static_cast<char>(j));
+        SerialWrite(frames::IsServoEnabled::Encode(j));
+
+        // 2. 응답이 올 때까지 이벤트 루프를 돌며 대기 (동기화)
+        QEventLoop loop;
+        QTimer timer;
+        timer.setSingleShot(true);
+
+        connect(this, &MyCobot::isServoEnabledReceived, &loop, &QEventLoop::quit); // 가상의 시그널
+        connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
+
+        timer.start(SERIAL_TIMEOUT);
+        loop.exec();
+
+        // 3. HandleReadyRead에 의해 업데이트된 최신 값을 반환
+        //    응답이 어떤 관절에 대한 것인지도 함께 처리해야 함
+        return servo_enabled[j];
+    }
+
+    bool MyCobot::IsAllServoEnabled()
+    {
+        // 1. IsAllServoEnabled 명령어(0x51)를 직접 보냄
+        SerialWrite(frames::IsAllServoEnabled::Encode());
+
+        // 2. 응답이 올 때까지 이벤트 루프를 돌며 대기 (동기화)
+        QEventLoop loop;
+        QTimer timer;
+        timer.setSingleShot(true);
+
+        connect(this, &MyCobot::isAllServoEnabledReceived, &loop, &QEventLoop::quit); // 가상의 시그널
+        connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
+
+        timer.start(SERIAL_TIMEOUT);
+        loop.exec();
+
+        // 3. HandleReadyRead에 의해 업데이트된 최신 값을 반환
+        return is_all_servo_enabled;
+    }
+
+    Angles rc::MyCobot::GetEncoders()
+    {
+        // 1. GetEncoders 명령어(0x3D)를 직접 보냄
+        SerialWrite(frames::GetEncoders::Encode());
+
+        // 2. 응답이 올 때까지 이벤트 루프를 돌며 대기 (동기화)
+        QEventLoop loop;
+        QTimer timer;
+        timer.setSingleShot(true);
+
+        connect(this, &MyCobot::encodersReceived, &loop, &QEventLoop::quit); // 이전에 정의한 시그널 재사용
+        connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
+
+        timer.start(SERIAL_TIMEOUT);
+        loop.exec();
+
+        // 3. HandleReadyRead에 의해 업데이트된 최신 값을 반환
+        return cur_encoders;
+    }
+
+    Angles MyCobot::GetAngles()
+    {
+        // 비동기 조회를 보내고 결과가 올 때까지 이벤트 루프를 돌며 대기 (동기화)
+        QEventLoop loop;
+        QueryResult<Angles> result;
+        bool finished = false;
+        GetAnglesAsync([&](const QueryResult<Angles> &r)
+                       {
+            result = r;
+            finished = true;
+            loop.quit(); });
+        if (!finished)
+        {
+            loop.exec();
+        }
+        if (!result.ok)
+        {
+            throw std::runtime_error(result.error);
+        }
+        return result.value;
+    }
+
+    void MyCobot::StartQuery(RequestType request_type, Joint joint, std::function<void(const char *error)> complete,
+                             const Coords &coords, bool is_linear)
+    {
+        if (!OnOwnerThread())
+        {
+            // 파이프라인과 조회 목록은 이 객체의 스레드만 씁니다. 다른 스레드의 호출은 그 스레드로 넘기고,
+            // 콜백(future 버전은 promise)도 그 스레드에서 완료됩니다.
+            QMetaObject::invokeMethod(this, [this, request_type, joint, complete = std::move(complete), coords, is_linear]() mutable
+                                      { StartQuery(request_type, joint, std::move(complete), coords, is_linear); },
+                                      Qt::QueuedConnection);
+            return;
+        }
+        const uint32_t query_id = m_next_query_id++;
+        if (m_next_query_id == 0)
+        {
+            m_next_query_id = 1; // 0은 일반 요청
+        }
+        m_queries[query_id] = PendingQuery{std::move(complete), coords, is_linear};
+
+        if (m_pipeline->Enqueue(request_type, joint, query_id) == EnqueueResult::Rejected)
+        {
+            FinishQuery(query_id, "Request queue is full.");
+            return;
+        }
+        try
+        {
+            processNextRequestInQueue();
+        }
+        catch (const std::exception &e)
+        {
+            // 보내지 못한 조회는 이미 콜백으로 실패가 전달되었습니다.
+            LogError << "Failed to dispatch queued requests: " << e.what();
+        }
+    }
+
+    void MyCobot::FinishQuery(uint32_t query_id, const char *error)
+    {
+        const auto it = m_queries.find(query_id);
+        if (it == m_queries.end())
+        {
+            return;
+        }
+        // 콜백 안에서 새 조회를 시작할 수 있으므로 먼저 목록에서 뺍니다.
+        const std::function<void(const char *)> complete = std::move(it->second.complete);
+        m_queries.erase(it);
+        if (complete)
+        {
+            complete(error);
+        }
+    }
+
+    void MyCobot::GetAnglesAsync(QueryCallback<Angles> done)
+    {
+        StartQuery(RequestType::REQ_Angles, Joint::J1, Completion(std::move(done), [this]()
+                                                                  { return cur_angles; }));
+    }
+
+    std::future<Angles> MyCobot::GetAnglesAsync()
+    {
+        return MakeFuture<Angles>([this](QueryCallback<Angles> done)
+                                  { GetAnglesAsync(std::move(done)); });
+    }
+
+    void MyCobot::GetEncodersAsync(QueryCallback<Angles> done)
+    {
+        StartQuery(RequestType::REQ_Encoders, Joint::J1, Completion(std::move(done), [this]()
+                                                                    { return cur_encoders; }));
+    }
+
+    std::future<Angles> MyCobot::GetEncodersAsync()
+    {
+        return MakeFuture<Angles>([this](QueryCallback<Angles> done)
+                                  { GetEncodersAsync(std::move(done)); });
+    }
 
-        command.append(FIRMATA_FOOTER);
-        SerialWrite(command);
+    void MyCobot::GetSpeedAsync(QueryCallback<double> done)
+    {
+        StartQuery(RequestType::REQ_Speed, Joint::J1, Completion(std::move(done), [this]()
+                                                                 { return cur_speed; }));
+    }
 
-        // 2. 응답이 올 때까지 이벤트 루프를 돌며 대기 (동기화)
-        QEventLoop loop;
-        QTimer timer;
-        timer.setSingleShot(true);
+    std::future<double> MyCobot::GetSpeedAsync()
+    {
+        return MakeFuture<double>([this](QueryCallback<double> done)
+                                  { GetSpeedAsync(std::move(done)); });
+    }
 
-        connect(this, &MyCobot::isServoEnabledReceived, &loop, &QEventLoop::quit); // 가상의 시그널
-        connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
+    void MyCobot::IsPowerOnAsync(QueryCallback<bool> done)
+    {
+        StartQuery(RequestType::REQ_IsPowerOn, Joint::J1, Completion(std::move(done), [this]()
+                                                                     { return is_powered_on; }));
+    }
 
-        timer.start(SERIAL_TIMEOUT);
-        loop.exec();
+    std::future<bool> MyCobot::IsPowerOnAsync()
+    {
+        return MakeFuture<bool>([this](QueryCallback<bool> done)
+                                { IsPowerOnAsync(std::move(done)); });
+    }
 
-        // 3. HandleReadyRead에 의해 업데이트된 최신 값을 반환
-        //    응답이 어떤 관절에 대한 것인지도 함께 처리해야 함
-        return servo_enabled[j];
+    void MyCobot::IsProgramPausedAsync(QueryCallback<bool> done)
+    {
+        StartQuery(RequestType::REQ_IsProgramPaused, Joint::J1, Completion(std::move(done), [this]()
+                                                                           { return is_program_paused; }));
     }
 
-    bool MyCobot::IsAllServoEnabled()
+    std::future<bool> MyCobot::IsProgramPausedAsync()
     {
-        // 1. IsAllServoEnabled 명령어(0x51)를 직접 보냄
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-        command.append(char(2));                          // LEN
-        command.append(char(Command::IsAllServoEnabled)); // 0x51
-        command.append(FIRMATA_FOOTER);
-        SerialWrite(command);
+        return MakeFuture<bool>([this](QueryCallback<bool> done)
+                                { IsProgramPausedAsync(std::move(done)); });
+    }
 
-        // 2. 응답이 올 때까지 이벤트 루프를 돌며 대기 (동기화)
-        QEventLoop loop;
-        QTimer timer;
-        timer.setSingleShot(true);
+    void MyCobot::IsInPositionAsync(const Coords &coords, bool is_linear, QueryCallback<bool> done)
+    {
+        StartQuery(RequestType::REQ_IsInPosition, Joint::J1, Completion(std::move(done), [this]()
+                                                                        { return is_in_position; }),
+                   coords, is_linear);
+    }
 
-        connect(this, &MyCobot::isAllServoEnabledReceived, &loop, &QEventLoop::quit); // 가상의 시그널
-        connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
+    std::future<bool> MyCobot::IsInPositionAsync(const Coords &coords, bool is_linear)
+    {
+        return MakeFuture<bool>([this, &coords, is_linear](QueryCallback<bool> done)
+                                { IsInPositionAsync(coords, is_linear, std::move(done)); });
+    }
 
-        timer.start(SERIAL_TIMEOUT);
-        loop.exec();
+    void MyCobot::IsServoEnabledAsync(Joint j, QueryCallback<bool> done)
+    {
+        // 응답 형식 [joint_id, state]에서 갱신된 해당 관절의 값을 읽습니다.
+        StartQuery(RequestType::REQ_IsServoEnabled, j, Completion(std::move(done), [this, j]()
+                                                                  { return servo_enabled[j - 1]; }));
+    }
 
-        // 3. HandleReadyRead에 의해 업데이트된 최신 값을 반환
-        return is_all_servo_enabled;
+    std::future<bool> MyCobot::IsServoEnabledAsync(Joint j)
+    {
+        return MakeFuture<bool>([this, j](QueryCallback<bool> done)
+                                { IsServoEnabledAsync(j, std::move(done)); });
     }
 
-    Angles rc::MyCobot::GetEncoders()
+    void MyCobot::IsAllServoEnabledAsync(QueryCallback<bool> done)
     {
-        // 1. GetEncoders 명령어(0x3D)를 직접 보냄
-        QByteArray command;
-        command.append(FIRMATA_HEADER);
-        command.append(char(2));                    // LEN
-        command.append(char(Command::GetEncoders)); // 0x3D
-        command.append(FIRMATA_FOOTER);
-        SerialWrite(command);
+        StartQuery(RequestType::REQ_IsAllServoEnabled, Joint::J1, Completion(std::move(done), [this]()
+                                                                             { return is_all_servo_enabled; }));
+    }
 
-        // 2. 응답이 올 때까지 이벤트 루프를 돌며 대기 (동기화)
-        QEventLoop loop;
-        QTimer timer;
-        timer.setSingleShot(true);
+    std::future<bool> MyCobot::IsAllServoEnabledAsync()
+    {
+        return MakeFuture<bool>([this](QueryCallback<bool> done)
+                                { IsAllServoEnabledAsync(std::move(done)); });
+    }
 
-        connect(this, &MyCobot::encodersReceived, &loop, &QEventLoop::quit); // 이전에 정의한 시그널 재사용
-        connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
+    void MyCobot::IsMovingAsync(QueryCallback<bool> done)
+    {
+        StartQuery(RequestType::REQ_IsMoving, Joint::J1, Completion(std::move(done), [this]()
+                                                                    { return robot_is_moving; }));
+    }
 
-        timer.start(SERIAL_TIMEOUT);
-        loop.exec();
+    std::future<bool> MyCobot::IsMovingAsync()
+    {
+        return MakeFuture<bool>([this](QueryCallback<bool> done)
+                                { IsMovingAsync(std::move(done)); });
+    }
 
-        // 3. HandleReadyRead에 의해 업데이트된 최신 값을 반환
-        return cur_encoders;
+    void MyCobot::SerialWrite(const QByteArray &data)
+    {
+        SerialWrite(data.constData(), static_cast<std::size_t>(data.size()));
     }
 
-    void MyCobot::SerialWrite(const QByteArray &data) const
+    void MyCobot::SerialWrite(const char *data, std::size_t size)
     {
         // LogDebug << "--> SENDING: " << data.toHex(' ').toUpper();
 
+        // 왕복 지연 측정을 위해 명령어 ID별 송신 시각을 기록합니다. [FE FE LEN CMD ...]
+        const unsigned char command = size >= 4 ? static_cast<unsigned char>(data[3]) : static_cast<unsigned char>(Command::Undefined);
+
+        // I/O 스레드 모드에서는 송신 큐에 넣기만 하고, 실제 write()는 I/O 스레드가 합니다.
+        if (m_io_worker)
+        {
+            if (!m_io_worker->IsOpen())
+            {
+                throw std::runtime_error("Serial write failed: Port is not open.");
+            }
+            if (!m_io_worker->Write(data, size))
+            {
+                LogError << "Could not write data: transmit queue is full.";
+                throw std::runtime_error("Serial write failed: transmit queue is full.");
+            }
+            m_latency->OnSent(command, std::chrono::steady_clock::now());
+            m_poll_rate->OnBytesSent(size);
+            CaptureBytes(true, data, size);
+            return;
+        }
+
         // 1. 쓰기 전에 포트가 열려 있는지 확인하는 방어 코드
         if (!serial_port || !serial_port->isOpen())
         {
             throw std::runtime_error("Serial write failed: Port is not open.");
         }
 
-        // 2. 실제 쓰기 작업 수행
-        const qint64 bytes_written = serial_port->write(data);
+        // 2. 송신 큐에 프레임을 쌓고, 이번 이벤트 루프 턴이 끝나면 한 번에 씁니다.
+        //    폴링 요청과 동작 명령이 연달아 나가도 write()는 한 번이며, flush()로 막지 않습니다.
+        m_tx_buffer.append(data, static_cast<int>(size));
+        ++m_tx_frames;
+        m_latency->OnSent(command, std::chrono::steady_clock::now());
+        m_poll_rate->OnBytesSent(size);
+        CaptureBytes(true, data, size);
+        if (!m_tx_flush_scheduled)
+        {
+            m_tx_flush_scheduled = true;
+            QMetaObject::invokeMethod(this, &MyCobot::FlushTxQueue, Qt::QueuedConnection);
+        }
+    }
+
+    void MyCobot::FlushTxQueue()
+    {
+        m_tx_flush_scheduled = false;
+        if (m_tx_buffer.isEmpty())
+        {
+            return;
+        }
+        if (!serial_port->isOpen())
+        {
+            m_tx_buffer.clear();
+            m_tx_frames = 0;
+            return;
+        }
+
+        const qint64 bytes_written = serial_port->write(m_tx_buffer);
+        const qint64 expected = m_tx_buffer.size();
+        m_tx_buffer.clear();
+        m_tx_frames = 0;
 
-        // 3. 쓰기 작업 결과 확인 및 예외 처리
-        if (bytes_written == -1)
+        if (bytes_written > 0)
+        {
+            m_tx_bytes_in_flight += bytes_written;
+        }
+        if (bytes_written != expected)
         {
-            // 쓰기 실패는 심각한 오류 (예: 연결 끊김)
-            std::string error_message = serial_port->errorString().toStdString();
-            LogError << "Could not write data: " << serial_port->errorString();
-            throw std::runtime_error("Serial write failed: " + error_message);
+            // 쓰기 실패는 호출한 함수가 이미 반환한 뒤에 알 수 있으므로 HandleError로 보고합니다.
+            LogError << "Could not write data: wrote " << bytes_written << " of " << expected
+                     << " bytes: " << serial_port->errorString();
+            // QSerialPort가 에러를 설정했다면 errorOccurred 시그널로 이미 HandleError가 호출됩니다.
+            if (serial_port->error() == QSerialPort::NoError)
+            {
+                HandleError(QSerialPort::WriteError);
+            }
         }
-        else if (bytes_written != data.size())
+    }
+
+    void MyCobot::HandleBytesWritten(qint64 bytes)
+    {
+        m_tx_bytes_in_flight = std::max<qint64>(m_tx_bytes_in_flight - bytes, 0);
+    }
+
+    std::size_t MyCobot::TxQueueDepth() const
+    {
+        if (m_io_worker)
         {
-            // 모든 데이터를 보내지 못한 경우도 오류로 간주
-            std::string error_message = "Wrote " + std::to_string(bytes_written) +
-                                        " bytes, but expected to write " + std::to_string(data.size()) + " bytes.";
-            LogError << "Failed to write all data. " << QString::fromStdString(error_message);
-            throw std::runtime_error("Incomplete serial write: " + error_message);
+            return m_io_worker->TxQueueDepth();
         }
+        return m_tx_frames;
+    }
 
-        // 4. 버퍼 비우기
-        // flush()도 실패할 수 있지만, 여기서는 write() 실패가 더 중요하므로 생략 가능
-        if (!serial_port->flush())
+    qint64 MyCobot::TxBytesPending() const
+    {
+        if (m_io_worker)
         {
-            qWarning() << "Serial port flush failed.";
+            return m_io_worker->TxBytesPending();
         }
+        return m_tx_buffer.size() + m_tx_bytes_in_flight;
     }
 
     void MyCobot::ResetInPositionFlag()
@@ -1042,193 +1946,339 @@ namespace rc
     void rc::MyCobot::HandleReadyRead()
     {
         // 단일 스레드 환경이므로 뮤텍스는 제거합니다.
-        read_data.append(serial_port->readAll());
-        // LogDebug << "<-- RECEIVED: " << read_data.toHex(' ').toUpper();
-
-        // 강화된 파서로 유효한 명령어만 추출합니다.
-        std::vector<std::pair<unsigned char, QByteArray>> parsed_commands = Parse(read_data);
-        if (parsed_commands.empty())
+        // readAll()로 QByteArray를 새로 만들지 않고, 스택 버퍼로 읽어 디코더 링 버퍼에 넣습니다.
+        char chunk[512];
+        bool any_packet = false;
+        qint64 bytes_read = 0;
+        while ((bytes_read = serial_port->read(chunk, sizeof(chunk))) > 0)
+        {
+            CaptureBytes(false, chunk, static_cast<std::size_t>(bytes_read));
+            if (FeedReceivedBytes(chunk, static_cast<std::size_t>(bytes_read)) > 0)
+            {
+                any_packet = true;
+            }
+        }
+        if (!any_packet)
         {
             return; // 처리할 명령이 없으면 종료
         }
+        OnPacketBatchDispatched();
+    }
 
-        // 2바이트를 16비트 정수로 디코딩하는 헬퍼 함수
-        auto decode_int16 = [](const QByteArray &data, int index) -> int16_t
+    std::size_t MyCobot::FeedReceivedBytes(const char *data, std::size_t size)
+    {
+        std::size_t packets = 0;
+        std::size_t offset = 0;
+        while (offset < size)
         {
-            if (index + 1 < data.size())
+            offset += m_decoder->Feed(data + offset, size - offset);
+
+            // 패킷 뷰는 다음 Feed() 전까지만 유효하므로 바로 처리합니다.
+            PacketView packet;
+            while (m_decoder->Next(packet))
             {
-                const uint8_t msb = static_cast<uint8_t>(data[index]);
-                const uint8_t lsb = static_cast<uint8_t>(data[index + 1]);
-                return static_cast<int16_t>((msb << 8) | lsb);
+                DispatchPacket(packet);
+                ++packets;
             }
-            return 0;
-        };
+        }
+        return packets;
+    }
 
-        // 파싱된 모든 명령어에 대해 처리
-        for (const auto &content : parsed_commands)
+    /**
+     * @brief [I/O 스레드 모드] I/O 스레드가 디코딩해 둔 패킷을 모두 꺼내 처리합니다.
+     */
+    void MyCobot::DrainIoQueue()
+    {
+        if (!m_io_worker)
         {
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wswitch-enum"
-            switch (static_cast<Command>(content.first))
-            {
-            // ======================================================
-            // Boolean (참/거짓) 상태 응답 처리
-            // ======================================================
-            case Command::IsPoweredOn:
+            return;
+        }
+        // 큐를 비우기 전에 알림을 다시 받을 수 있도록 합니다.
+        m_io_worker->RearmNotify();
+
+        RxPacket packet;
+        bool any_packet = false;
+        while (m_io_worker->Pop(packet))
+        {
+            if (m_capture)
             {
-                is_powered_on = static_cast<bool>(content.second.at(0));
-                emit isPoweredOnReceived(); // IsPowerOn()을 깨움
-                break;
+                // 원본 바이트는 I/O 스레드에서 디코딩되므로 프레임을 다시 만들어 기록합니다. [FE FE LEN CMD payload FA]
+                char frame[PacketDecoder::MaxPacketSize + 2];
+                frame[0] = frame[1] = static_cast<char>(0xFE);
+                frame[2] = static_cast<char>(packet.size + 2);
+                frame[3] = static_cast<char>(packet.command);
+                std::memcpy(frame + 4, packet.data, packet.size);
+                frame[4 + packet.size] = static_cast<char>(0xFA);
+                CaptureBytes(false, frame, packet.size + 5u);
             }
-            case Command::CheckRunning:
+            DispatchPacket(packet.View());
+            any_packet = true;
+        }
+        if (any_packet)
+        {
+            OnPacketBatchDispatched();
+        }
+    }
+
+    /**
+     * @brief 한 번의 수신 처리(readyRead 또는 큐 비우기)가 끝난 뒤 스케줄러를 진행합니다.
+     */
+    void MyCobot::OnPacketBatchDispatched()
+    {
+        EmitChangeNotifications();
+        // 응답으로 비워진 window 자리만큼 바로 다음 요청을 보냅니다.
+        processNextRequestInQueue();
+    }
+
+    /**
+     * @brief 디코딩된 패킷 하나를 캐시에 반영하고 해당 시그널을 보냅니다.
+     */
+    void MyCobot::DispatchPacket(const PacketView &packet)
+    {
+        const auto received_at = std::chrono::steady_clock::now();
+        // 요청을 보낸 시각: 스케줄러 요청이면 짝지어진 요청, 아니면 명령어별 송신 기록, 둘 다 없으면 수신 시각
+        auto sent_at = received_at;
+        PendingRequest matched;
+        bool is_response = false;
+        if (m_replay_pipeline)
+        {
+            // 캡처 재생: 캡처된 송신 프레임과 짝짓고, 캡처에 기록된 왕복 시간만큼 앞을 송신 시각으로 씁니다.
+            // 지연/링크 통계는 실제 통신만 반영하므로 건드리지 않습니다.
+            is_response = m_replay_pipeline->Complete(packet.command, matched);
+            if (is_response)
             {
-                robot_is_moving = static_cast<bool>(content.second.at(0));
-                emit checkRunningReceived(); // CheckRunning()을 깨움
-                break;
+                sent_at = received_at - (m_replay_captured_at - matched.sent_at);
             }
-            case Command::IsInPosition:
+        }
+        else
+        {
+            m_latency->OnReceived(packet.command, received_at, &sent_at);
+            // 프레임 전체 바이트: FE FE LEN CMD payload FA
+            m_poll_rate->OnBytesReceived(packet.size + 5);
+
+            // 응답을 in-flight 요청과 짝짓습니다. (명령어 ID + FIFO)
+            is_response = m_pipeline->Complete(packet.command, matched);
+            if (is_response)
             {
-                is_in_position = static_cast<bool>(content.second.at(0));
-                emit isInPositionReceived(); // IsInPosition()을 깨움
-                break;
+                m_poll_rate->OnRoundTrip(received_at - matched.sent_at);
+                sent_at = matched.sent_at;
             }
-            case Command::IsProgramPaused:
-            {
-                is_program_paused = static_cast<bool>(content.second.at(0));
-                emit programPausedStatusReceived(); // IsProgramPaused()을 깨움
-                break;
+        }
+        // 캐시 채널 하나를 갱신할 때마다 수신 정보를 남기고 이력에 넣습니다.
+        const auto record = [this, &sent_at, &received_at](auto &ring, TelemetryChannel channel, const auto &value, SampleInfo &info)
+        {
+            info.sent_at = sent_at;
+            info.received_at = received_at;
+            ++info.sequence;
+            const auto sample = MakeSample(value, info);
+            ring.Push(sample);
+            m_recorder->Record(channel, sample);
+            m_change_filter->Offer(channel, value);
+        };
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wswitch-enum"
+        switch (static_cast<Command>(packet.command))
+        {
+        // ======================================================
+        // Boolean (참/거짓) 상태 응답 처리
+        // ======================================================
+        case Command::IsPoweredOn:
+        {
+            is_powered_on = static_cast<bool>(packet.At(0));
+            emit isPoweredOnReceived(); // IsPowerOn()을 깨움
+            break;
+        }
+        case Command::CheckRunning:
+        {
+            robot_is_moving = static_cast<bool>(packet.At(0));
+            record(m_history->is_moving, TelemetryChannel::CH_IsMoving, robot_is_moving, m_is_moving_info);
+            m_motion_polling->OnIsMoving(robot_is_moving, received_at);
+            emit checkRunningReceived(); // CheckRunning()을 깨움
+            break;
+        }
+        case Command::IsInPosition:
+        {
+            is_in_position = static_cast<bool>(packet.At(0));
+            emit isInPositionReceived(); // IsInPosition()을 깨움
+            break;
+        }
+        case Command::IsProgramPaused:
+        {
+            is_program_paused = static_cast<bool>(packet.At(0));
+            emit programPausedStatusReceived(); // IsProgramPaused()을 깨움
+            break;
+        }
+        case Command::IsAllServoEnabled:
+        {
+            is_all_servo_enabled = static_cast<bool>(packet.At(0));
+            emit isAllServoEnabledReceived(); // IsAllServoEnabled()을 깨움
+            break;
+        }
+        case Command::IsServoEnabled:
+        {
+            if (packet.size >= 2)
+            { // 응답 형식: [joint_id, state]
+                servo_enabled[static_cast<uint8_t>(packet.At(0)) - 1] = static_cast<bool>(packet.At(1));
             }
-            case Command::IsAllServoEnabled:
+            emit isServoEnabledReceived(); // IsServoEnabled()을 깨움
+            break;
+        }
+        // ======================================================
+        // 배열(Array) 형태의 데이터 응답 처리
+        // ======================================================
+        case Command::GetAngles:
+        {
+            if (packet.size >= 12)
             {
-                is_all_servo_enabled = static_cast<bool>(content.second.at(0));
-                emit isAllServoEnabledReceived(); // IsAllServoEnabled()을 깨움
-                break;
+                for (size_t i = 0; i < rc::Joints; ++i)
+                {
+                    cur_angles[i] = static_cast<double>(packet.Int16(i * 2)) / 100.0;
+                }
+                record(m_history->angles, TelemetryChannel::CH_Angles, cur_angles, m_angles_info);
+                UpdateMotionEstimate(*m_angle_estimator, m_joint_motion_info, cur_angles, m_angles_info);
             }
-            case Command::IsServoEnabled:
+            emit anglesReceived(); // GetAngles()을 깨움
+            break;
+        }
+        case Command::GetCoords:
+        {
+            if (packet.size >= 12)
             {
-                if (content.second.size() >= 2)
-                { // 응답 형식: [joint_id, state]
-                    servo_enabled[static_cast<uint8_t>(content.second.at(0)) - 1] = static_cast<bool>(content.second.at(1));
-                }
-                emit isServoEnabledReceived(); // IsServoEnabled()을 깨움
-                break;
+                for (size_t i = 0; i < 3; ++i)
+                    cur_coords[i] = static_cast<double>(packet.Int16(i * 2)) / 10.0;
+                for (size_t i = 3; i < rc::Axes; ++i)
+                    cur_coords[i] = static_cast<double>(packet.Int16(i * 2)) / 100.0;
+                record(m_history->coords, TelemetryChannel::CH_Coords, cur_coords, m_coords_info);
+                UpdateMotionEstimate(*m_coord_estimator, m_coord_motion_info, cur_coords, m_coords_info);
             }
-            // ======================================================
-            // 배열(Array) 형태의 데이터 응답 처리
-            // ======================================================
-            case Command::GetAngles:
+            emit coordsReceived(); // GetCoords()가 동기식이면 필요
+            break;
+        }
+        case Command::GetEncoders:
+        {
+            if (packet.size >= 12)
             {
-                if (content.second.size() >= 12)
+                for (size_t i = 0; i < rc::Joints; ++i)
                 {
-                    for (size_t i = 0; i < rc::Joints; ++i)
-                    {
-                        cur_angles[i] = static_cast<double>(decode_int16(content.second, i * 2)) / 100.0;
-                    }
+                    cur_encoders[i] = static_cast<double>(packet.Int16(i * 2));
                 }
-                emit anglesReceived(); // GetAngles()을 깨움
-                break;
+                record(m_history->encoders, TelemetryChannel::CH_Encoders, cur_encoders, m_encoders_info);
+                UpdateMotionEstimate(*m_encoder_estimator, m_encoder_motion_info, cur_encoders, m_encoders_info);
             }
-            case Command::GetCoords:
+            emit encodersReceived(); // GetEncoders()을 깨움
+            break;
+        }
+        case Command::GetServoData: // 0x53에 대한 응답
+        {
+            // 응답에는 관절 번호가 없으므로 짝지어진 요청으로만 관절을 정합니다. 짝이 없는 응답은
+            // 타임아웃된 요청의 늦은 응답이므로 (재동기화 구간) 어느 관절의 것인지 알 수 없어 버립니다.
+            if (!is_response)
             {
-                if (content.second.size() >= 12)
-                {
-                    for (size_t i = 0; i < 3; ++i)
-                        cur_coords[i] = static_cast<double>(decode_int16(content.second, i * 2)) / 10.0;
-                    for (size_t i = 3; i < rc::Axes; ++i)
-                        cur_coords[i] = static_cast<double>(decode_int16(content.second, i * 2)) / 100.0;
-                }
-                emit coordsReceived(); // GetCoords()가 동기식이면 필요
+                LogDebug << "Dropped a GetServoData reply with no matching request (late reply after timeout).";
                 break;
             }
-            case Command::GetEncoders:
+            int joint_index = matched.external ? -1 : static_cast<int>(matched.joint) - 1; // 동기 GetServoData는 부하 값이 아닐 수 있음
+
+            if (packet.size >= 2)
             {
-                if (content.second.size() >= 12)
-                {
-                    for (size_t i = 0; i < rc::Joints; ++i)
-                    {
-                        cur_encoders[i] = static_cast<double>(decode_int16(content.second, i * 2));
-                    }
-                }
-                emit encodersReceived(); // GetEncoders()을 깨움
-                break;
+                last_servo_data_value = packet.Int16(0);
             }
-            case Command::GetServoData: // 0x53에 대한 응답
+            else if (packet.size == 1)
             {
-                // 가장 최근에 요청했던 관절의 부하 값으로 간주하고 저장합니다.
-                int joint_index = static_cast<int>(m_last_requested_load_joint) - 1;
-
-                if (joint_index >= 0 && joint_index < Joints)
-                {
-                    if (content.second.size() >= 2)
-                    {
-                        real_cur_loads[joint_index] = decode_int16(content.second, 0);
-                    }
-                    else if (content.second.size() == 1)
-                    {
-                        real_cur_loads[joint_index] = static_cast<uint8_t>(content.second.at(0));
-                    }
-                }
-                break;
+                last_servo_data_value = static_cast<uint8_t>(packet.At(0));
             }
-            // ======================================================
-            // 우리가 추가한 실시간 데이터 응답 처리
-            // ======================================================
-            case Command::GET_SERVO_SPEEDS:
+
+            if (joint_index >= 0 && joint_index < Joints && packet.size >= 1)
             {
-                if (content.second.size() >= 12)
+                const auto load_index = static_cast<std::size_t>(joint_index);
+                real_cur_loads[load_index] = last_servo_data_value;
+                record(m_history->loads[load_index], static_cast<TelemetryChannel>(static_cast<std::size_t>(TelemetryChannel::CH_LoadJ1) + load_index),
+                       real_cur_loads[load_index], m_load_info[load_index]);
+
+                if (m_load_sweep_active)
                 {
-                    for (size_t i = 0; i < rc::Joints; ++i)
+                    m_load_sweep_values[load_index] = last_servo_data_value;
+                    m_load_sweep_mask |= 1u << load_index;
+                    if (m_load_sweep_mask == (1u << Joints) - 1)
                     {
-                        real_cur_speeds[i] = decode_int16(content.second, i * 2);
+                        // 여섯 관절을 모두 받으면 한 번에 갱신합니다.
+                        m_load_sweep.loads = m_load_sweep_values;
+                        m_load_sweep.completed_at = received_at;
+                        ++m_load_sweep.sequence;
+                        m_load_sweep_active = false;
+                        emit loadSweepReceived();
                     }
                 }
-                // emit speedsReceived(); // GetJointsRealSpeeds()을 깨움
-                break;
             }
-            // ★★★ 여기에 아래 case 블록을 추가합니다. ★★★
-            case Command::GET_SERVO_VOLTAGES:
+            emit servoDataReceived(); // GetServoData()를 깨움
+            break;
+        }
+        // ======================================================
+        // 우리가 추가한 실시간 데이터 응답 처리
+        // ======================================================
+        case Command::GET_SERVO_SPEEDS:
+        {
+            if (packet.size >= 12)
             {
-                // 로봇은 6바이트의 데이터를 보냅니다.
-                if (content.second.size() >= 6)
+                for (size_t i = 0; i < rc::Joints; ++i)
                 {
-                    for (size_t i = 0; i < rc::Joints; ++i)
-                    {
-                        // 각 관절당 1바이트 값을 읽습니다.
-                        int raw_voltage = static_cast<uint8_t>(content.second.at(i));
-
-                        // 10.0으로 나누어 실제 전압(Volt) 단위로 변환합니다.
-                        real_cur_voltages[i] = static_cast<double>(raw_voltage) / 10.0;
-                    }
+                    real_cur_speeds[i] = packet.Int16(i * 2);
                 }
-                // 비동기 방식이므로 emit은 필요 없습니다.
-                // emit voltagesReceived(); // 만약 동기식 GetVoltages() 함수를 만든다면 필요합니다.
-                break;
+                record(m_history->speeds, TelemetryChannel::CH_Speeds, real_cur_speeds, m_speeds_info);
             }
-            // ======================================================
-            // 기타 단일 값 응답 처리
-            // ======================================================
-            case Command::GetSpeed:
+            // emit speedsReceived(); // GetJointsRealSpeeds()을 깨움
+            break;
+        }
+        // ★★★ 여기에 아래 case 블록을 추가합니다. ★★★
+        case Command::GET_SERVO_VOLTAGES:
+        {
+            // 로봇은 6바이트의 데이터를 보냅니다.
+            if (packet.size >= 6)
             {
-                if (!content.second.isEmpty())
+                for (size_t i = 0; i < rc::Joints; ++i)
                 {
-                    cur_speed = static_cast<double>(content.second.at(0));
+                    // 각 관절당 1바이트 값을 읽습니다.
+                    int raw_voltage = static_cast<uint8_t>(packet.At(i));
+
+                    // 10.0으로 나누어 실제 전압(Volt) 단위로 변환합니다.
+                    real_cur_voltages[i] = static_cast<double>(raw_voltage) / 10.0;
                 }
-                emit speedReceived(); // GetSpeed()을 깨움
-                break;
+                record(m_history->voltages, TelemetryChannel::CH_Voltages, real_cur_voltages, m_voltages_info);
             }
-            default:
+            // 비동기 방식이므로 emit은 필요 없습니다.
+            // emit voltagesReceived(); // 만약 동기식 GetVoltages() 함수를 만든다면 필요합니다.
+            break;
+        }
+        // ======================================================
+        // 기타 단일 값 응답 처리
+        // ======================================================
+        case Command::GetSpeed:
+        {
+            if (packet.size > 0)
             {
-                LogDebug << "Unhandled command: <" << Qt::hex << content.first << ", " << content.second.toHex(' ').toUpper() << ">";
-                break;
+                cur_speed = static_cast<double>(packet.At(0));
             }
-            }
-#pragma GCC diagnostic pop
+            emit speedReceived(); // GetSpeed()을 깨움
+            break;
+        }
+        default:
+        {
+            LogDebug << "Unhandled command: <" << Qt::hex << packet.command << ", "
+                     << QByteArray::fromRawData(reinterpret_cast<const char *>(packet.data), static_cast<int>(packet.size)).toHex(' ').toUpper() << ">";
+            break;
+        }
         }
-        // ★★★ "착륙 완료" 보고 ★★★
-        m_scheduler_is_busy = false;
+#pragma GCC diagnostic pop
+
+        // 다른 스레드의 Peek*가 이 패킷까지 반영된 상태를 한꺼번에 보도록 게시합니다.
+        PublishState();
 
-        // ★★★ 10ms의 안전 간격을 두고 다음 요청을 처리할지 확인합니다. ★★★
-        QTimer::singleShot(10, this, &MyCobot::processNextRequestInQueue);
+        // 캐시를 갱신한 뒤에 비동기 조회를 끝내야 콜백이 새 값을 읽습니다.
+        if (is_response && matched.query_id != 0)
+        {
+            FinishQuery(matched.query_id, nullptr);
+        }
     }
 
     void MyCobot::HandleTimeout()
@@ -1267,62 +2317,6 @@ namespace rc
         }
     }
 
-    std::vector<std::pair<unsigned char, QByteArray>> MyCobot::Parse(QByteArray &data)
-    {
-        std::vector<std::pair<unsigned char, QByteArray>> parsed_commands;
-        while (data.size() >= 4)
-        {
-            int head_idx = data.indexOf(FIRMATA_HEADER);
-            if (head_idx == -1)
-            {
-                data.clear();
-                return parsed_commands;
-            }
-
-            if (head_idx > 0)
-            {
-                data.remove(0, head_idx);
-            }
-
-            if (data.size() < 3)
-            { // 헤더(2) + 길이(1) 필드까지는 있어야 함
-                break;
-            }
-
-            // 데이터 길이(LEN) 필드 읽기
-            const int len_field = static_cast<unsigned char>(data[2]);
-            // ★★★ 전체 패킷 길이는 (LEN 필드 값 + 3) 이 올바른 계산입니다. ★★★
-            // 헤더(2) + 길이필드(1) + 명령어(1) + 데이터(N) + 푸터(1)
-            // Python 소스 기준: L = N + 2 이므로, Total = 2+1+1+N+1 = 2+1+1+(L-2)+1 = L+3
-            const int total_packet_len = len_field + 3;
-
-            if (data.size() < total_packet_len)
-            {
-                // 아직 패킷이 다 도착하지 않음
-                break;
-            }
-
-            if (static_cast<unsigned char>(data[total_packet_len - 1]) == 0xFA)
-            {
-                // 유효한 패킷 발견!
-                unsigned char cmd_id = static_cast<unsigned char>(data[3]);
-                // 실제 데이터 (명령어 ID 다음부터 푸터 전까지)
-                QByteArray command_data = data.mid(4, len_field - 2);
-
-                parsed_commands.push_back({cmd_id, command_data});
-
-                // 처리된 패킷을 버퍼에서 제거
-                data.remove(0, total_packet_len);
-            }
-            else
-            {
-                // 푸터가 일치하지 않으면 헤더가 잘못된 것으로 간주하고 한 바이트만 버림
-                data.remove(0, 1);
-            }
-        }
-        return parsed_commands;
-    }
-
     // void MyCobot::SetFreeMove(bool on)
     // {
     //     LogTrace << "(" << on << ")";
@@ -0,0 +1,168 @@
+#include "PacketDecoder.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace rc
+{
+
+    namespace
+    {
+        constexpr unsigned char HeaderByte = 0xFE;
+        constexpr unsigned char FooterByte = 0xFA;
+    }
+
+    PacketDecoder::PacketDecoder(std::size_t capacity_)
+        : capacity(std::max(capacity_, MaxPacketSize))
+    {
+        buffer.resize(capacity + MaxPacketSize);
+    }
+
+    std::size_t PacketDecoder::Feed(const char *data, std::size_t size)
+    {
+        const std::size_t accepted = std::min(size, FreeSpace());
+        const unsigned char *src = reinterpret_cast<const unsigned char *>(data);
+
+        std::size_t tail = head + count;
+        if (tail >= capacity)
+        {
+            tail -= capacity;
+        }
+
+        // 링의 끝까지 한 번, 넘치는 부분은 앞쪽에 한 번 복사합니다.
+        const std::size_t first = std::min(accepted, capacity - tail);
+        std::memcpy(&buffer[tail], src, first);
+        if (accepted > first)
+        {
+            std::memcpy(&buffer[0], src + first, accepted - first);
+        }
+
+        // 버퍼 앞쪽 MaxPacketSize 바이트가 바뀌었다면 미러 영역도 갱신합니다.
+        const std::size_t front_end = tail < MaxPacketSize ? std::min(tail + first, MaxPacketSize) : 0;
+        if (front_end > tail)
+        {
+            std::memcpy(&buffer[capacity + tail], &buffer[tail], front_end - tail);
+        }
+        if (accepted > first)
+        {
+            const std::size_t wrapped = std::min(accepted - first, MaxPacketSize);
+            std::memcpy(&buffer[capacity], &buffer[0], wrapped);
+        }
+
+        count += accepted;
+        return accepted;
+    }
+
+    bool PacketDecoder::Next(PacketView &packet)
+    {
+        while (count >= 4)
+        {
+            // 헤더(0xFE 0xFE) 위치를 찾습니다.
+            const std::size_t head_idx = FindHeader();
+            if (head_idx >= count)
+            {
+                // 헤더가 없으면 버립니다. 단, 마지막 0xFE는 다음 헤더의 첫 바이트일 수 있으므로 남겨 둡니다.
+                const std::size_t garbage = Peek(count - 1) == HeaderByte ? count - 1 : count;
+                stats.discarded_bytes += garbage;
+                Drop(garbage);
+                return false;
+            }
+            stats.discarded_bytes += head_idx;
+            Drop(head_idx);
+
+            if (count < 3)
+            { // 헤더(2) + 길이(1) 필드까지는 있어야 함
+                return false;
+            }
+
+            // 전체 패킷 길이 = 헤더(2) + 길이필드(1) + 명령어(1) + 데이터(N) + 푸터(1) = LEN + 3
+            const std::size_t len_field = Peek(2);
+            const std::size_t total_packet_len = len_field + 3;
+            if (count < total_packet_len)
+            {
+                // 아직 패킷이 다 도착하지 않음
+                return false;
+            }
+
+            if (Peek(total_packet_len - 1) == FooterByte)
+            {
+                // 미러 영역 덕분에 head부터 total_packet_len 바이트는 항상 연속입니다.
+                packet.command = buffer[head + 3];
+                packet.data = &buffer[head + 4];
+                packet.size = len_field >= 2 ? len_field - 2 : 0;
+                Drop(total_packet_len);
+                ++stats.packets;
+                return true;
+            }
+
+            // 푸터가 일치하지 않으면 헤더가 잘못된 것으로 간주하고 한 바이트만 버림
+            ++stats.resyncs;
+            ++stats.discarded_bytes;
+            Drop(1);
+        }
+        return false;
+    }
+
+    void PacketDecoder::Clear()
+    {
+        head = 0;
+        count = 0;
+    }
+
+    unsigned char PacketDecoder::Peek(std::size_t offset) const
+    {
+        std::size_t pos = head + offset;
+        if (pos >= capacity)
+        {
+            pos -= capacity;
+        }
+        return buffer[pos];
+    }
+
+    std::size_t PacketDecoder::FindHeader() const
+    {
+        // 링의 [head, 끝)과 [0, 나머지) 두 구간을 memchr로 훑습니다.
+        const std::size_t first_len = std::min(count, capacity - head);
+        const unsigned char *segments[2] = {&buffer[head], &buffer[0]};
+        const std::size_t lengths[2] = {first_len, count - first_len};
+
+        std::size_t base = 0;
+        for (std::size_t s = 0; s < 2; ++s)
+        {
+            const unsigned char *begin = segments[s];
+            const unsigned char *end = begin + lengths[s];
+            const unsigned char *p = begin;
+            while (p < end)
+            {
+                p = static_cast<const unsigned char *>(std::memchr(p, HeaderByte, static_cast<std::size_t>(end - p)));
+                if (!p)
+                {
+                    break;
+                }
+                const std::size_t offset = base + static_cast<std::size_t>(p - begin);
+                if (offset + 1 < count && Peek(offset + 1) == HeaderByte)
+                {
+                    return offset;
+                }
+                ++p;
+            }
+            base += lengths[s];
+        }
+        return count;
+    }
+
+    void PacketDecoder::Drop(std::size_t n)
+    {
+        head += n;
+        if (head >= capacity)
+        {
+            head -= capacity;
+        }
+        count -= n;
+        if (count == 0)
+        {
+            head = 0;
+        }
+    }
+
+}
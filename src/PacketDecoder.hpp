@@ -0,0 +1,105 @@
+#ifndef ROBOSIGNAL_PACKETDECODER_HPP
+#define ROBOSIGNAL_PACKETDECODER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace rc
+{
+
+    /**
+     * @brief 디코더 내부 버퍼를 가리키는 패킷 뷰 (복사 없음).
+     * data는 명령어 ID 다음 바이트부터 푸터 전까지를 가리킵니다.
+     * 다음 PacketDecoder::Feed() 호출 전까지만 유효합니다.
+     */
+    struct PacketView
+    {
+        unsigned char command{0};
+        const unsigned char *data{nullptr};
+        std::size_t size{0};
+
+        /// 범위를 벗어나면 0을 반환합니다.
+        unsigned char At(std::size_t index) const
+        {
+            return index < size ? data[index] : 0;
+        }
+
+        /// index 위치의 Big-Endian 2바이트를 16비트 정수로 디코딩합니다.
+        int16_t Int16(std::size_t index) const
+        {
+            if (index + 1 < size)
+            {
+                return static_cast<int16_t>((data[index] << 8) | data[index + 1]);
+            }
+            return 0;
+        }
+    };
+
+    /// 디코더 누적 통계
+    struct DecoderStats
+    {
+        uint64_t packets{0};         // 꺼낸 유효 패킷 수
+        uint64_t resyncs{0};         // 헤더 후보가 LEN/푸터 검증에 실패해 다시 동기화한 횟수
+        uint64_t discarded_bytes{0}; // 패킷에 속하지 않아 버린 바이트 수
+    };
+
+    /**
+     * @brief 고정 크기 링 버퍼 위에서 동작하는 스트리밍 Firmata 패킷 디코더.
+     *
+     * 헤더(0xFE 0xFE), LEN, 푸터(0xFA) 검증 규칙은 기존 MyCobot::Parse와 같습니다.
+     * 버퍼 뒤에 최대 패킷 크기만큼의 미러 영역을 두어, 링의 끝을 넘어가는 패킷도
+     * 연속된 메모리로 볼 수 있습니다. 따라서 패킷을 꺼낼 때 버퍼를 당기거나
+     * 페이로드를 복사하지 않습니다.
+     *
+     * 헤더는 memchr로 0xFE를 찾아 다음 바이트를 확인하는 방식으로 찾습니다.
+     * 검증에 실패한 후보는 첫 바이트만 버리고 그 다음 위치부터 이어서 찾으므로,
+     * 이미 버린 바이트를 다시 검사하지 않습니다.
+     */
+    class PacketDecoder
+    {
+    public:
+        /// 헤더(2) + LEN(1) + LEN 필드 최대값(255)
+        static constexpr std::size_t MaxPacketSize = 2 + 1 + 255;
+        static constexpr std::size_t DefaultCapacity = 4096;
+
+        explicit PacketDecoder(std::size_t capacity = DefaultCapacity);
+
+        /**
+         * @brief 수신한 바이트를 버퍼에 추가합니다.
+         * @return 실제로 받아들인 바이트 수. 버퍼가 가득 차면 size보다 작을 수 있으며,
+         * 이 경우 Next()로 패킷을 꺼낸 뒤 나머지를 다시 넣어야 합니다.
+         */
+        std::size_t Feed(const char *data, std::size_t size);
+
+        /**
+         * @brief 다음 유효 패킷을 꺼냅니다.
+         * @return 패킷이 있으면 true. 불완전한 패킷은 버퍼에 남겨 둡니다.
+         */
+        bool Next(PacketView &packet);
+
+        /// 아직 소비되지 않은 바이트 수
+        std::size_t Size() const { return count; }
+        std::size_t Capacity() const { return capacity; }
+        std::size_t FreeSpace() const { return capacity - count; }
+        void Clear();
+
+        const DecoderStats &Stats() const { return stats; }
+        void ResetStats() { stats = DecoderStats{}; }
+
+    private:
+        unsigned char Peek(std::size_t offset) const;
+        void Drop(std::size_t n);
+        /// 헤더(0xFE 0xFE)의 시작 오프셋. 없으면 count를 반환합니다.
+        std::size_t FindHeader() const;
+
+    private:
+        std::size_t capacity;
+        std::vector<unsigned char> buffer{}; // capacity + MaxPacketSize (미러 영역 포함)
+        std::size_t head{0};                 // 읽기 위치
+        std::size_t count{0};                // 읽지 않은 바이트 수
+        DecoderStats stats{};
+    };
+
+}
+#endif
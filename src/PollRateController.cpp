@@ -0,0 +1,94 @@
+#include "PollRateController.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace rc
+{
+
+    namespace
+    {
+        constexpr double EwmaAlpha = 0.25;  // 새 측정값의 가중치
+        constexpr double DecayAlpha = 0.25; // 주기를 줄일 때 목표로 다가가는 비율
+        constexpr double BitsPerByte = 10.0; // 8N1: start + 8 data + stop
+
+        double Ewma(double average, double sample, bool first)
+        {
+            return first ? sample : average + EwmaAlpha * (sample - average);
+        }
+    }
+
+    void PollRateController::SetBaudRate(int baud_rate_)
+    {
+        baud_rate = std::max(baud_rate_, 1);
+    }
+
+    void PollRateController::SetTargetUtilization(double target_utilization_)
+    {
+        target_utilization = std::clamp(target_utilization_, 0.05, 1.0);
+    }
+
+    void PollRateController::SetStalenessBudget(std::chrono::milliseconds budget)
+    {
+        staleness_budget = std::max(budget, MinPeriod);
+    }
+
+    void PollRateController::OnRoundTrip(Clock::duration rtt)
+    {
+        const double sample = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(rtt).count());
+        rtt_us = Ewma(rtt_us, std::max(sample, 0.0), rtt_samples++ == 0);
+    }
+
+    std::chrono::microseconds PollRateController::Update(Clock::time_point now, int window)
+    {
+        const double bytes = static_cast<double>(tx_bytes + rx_bytes);
+        const double byte_time_us = BitsPerByte * 1e6 / static_cast<double>(baud_rate);
+        tx_bytes = 0;
+        rx_bytes = 0;
+
+        if (has_last_update)
+        {
+            const double elapsed_us = static_cast<double>(
+                std::chrono::duration_cast<std::chrono::microseconds>(now - last_update).count());
+            utilization = elapsed_us > 0.0 ? bytes * byte_time_us / elapsed_us : 0.0;
+            bytes_per_poll = Ewma(bytes_per_poll, bytes, poll_samples++ == 0);
+        }
+        last_update = now;
+        has_last_update = true;
+
+        // 폴링 1회의 선로 시간과 왕복 지연으로 정한 하한들
+        const double wire_us = bytes_per_poll * byte_time_us;
+        const double rtt_bound_us = rtt_us / static_cast<double>(std::max(window, 1));
+        const double min_us = static_cast<double>(std::chrono::microseconds{MinPeriod}.count());
+        const double budget_us = static_cast<double>(std::chrono::microseconds{staleness_budget}.count());
+
+        double target_us = std::max({wire_us / target_utilization, rtt_bound_us, min_us});
+        if (target_us > budget_us)
+        {
+            // 목표 사용률로는 budget을 지킬 수 없으면 링크를 꽉 채우는 데까지 허용합니다.
+            target_us = std::max({budget_us, wire_us, rtt_bound_us, min_us});
+        }
+        over_budget = target_us > budget_us;
+
+        // 링크가 넘치지 않도록 늘릴 때는 바로, 줄일 때는 천천히 따라갑니다.
+        double period_us = static_cast<double>(period.count());
+        period_us = target_us >= period_us ? target_us : period_us + DecayAlpha * (target_us - period_us);
+        period = std::chrono::microseconds{static_cast<int64_t>(std::llround(period_us))};
+        return period;
+    }
+
+    void PollRateController::Reset(std::chrono::microseconds period_)
+    {
+        tx_bytes = 0;
+        rx_bytes = 0;
+        has_last_update = false;
+        rtt_samples = 0;
+        poll_samples = 0;
+        bytes_per_poll = 0.0;
+        rtt_us = 0.0;
+        utilization = 0.0;
+        over_budget = false;
+        period = period_;
+    }
+
+}
@@ -0,0 +1,81 @@
+#ifndef ROBOSIGNAL_POLLRATECONTROLLER_HPP
+#define ROBOSIGNAL_POLLRATECONTROLLER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace rc
+{
+
+    /**
+     * @brief 측정한 링크 사용률과 왕복 지연으로 폴링 주기를 정합니다.
+     *
+     * 폴링 한 번마다 Update()를 호출하면, 그 사이 송수신한 바이트로 폴링 1회당
+     * 선로 시간(바이트 × 10비트 / 보레이트)을 추정하고 다음 세 하한 중 가장 큰 값을
+     * 주기로 삼습니다.
+     *   - 선로 시간 / 목표 사용률
+     *   - 평균 왕복 지연 / in-flight window
+     *   - 최소 주기
+     * 이 값이 staleness budget보다 크면 사용률 100%까지 허용해 budget을 지키려 하고,
+     * 그래도 넘으면 OverBudget()이 true가 됩니다. 주기는 늘어날 때는 바로 따라가고,
+     * 줄어들 때는 천천히 줄입니다.
+     */
+    class PollRateController
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr double DefaultTargetUtilization = 0.5;
+        static constexpr std::chrono::milliseconds DefaultStalenessBudget{100};
+        static constexpr std::chrono::milliseconds MinPeriod{2};
+
+        void SetBaudRate(int baud_rate);
+        /// 목표 링크 사용률 (0.05 ~ 1.0)
+        void SetTargetUtilization(double target_utilization);
+        double TargetUtilization() const { return target_utilization; }
+        /// 캐시된 값이 이보다 오래되지 않도록 하는 최대 주기
+        void SetStalenessBudget(std::chrono::milliseconds budget);
+        std::chrono::milliseconds StalenessBudget() const { return staleness_budget; }
+
+        void OnBytesSent(std::size_t bytes) { tx_bytes += bytes; }
+        void OnBytesReceived(std::size_t bytes) { rx_bytes += bytes; }
+        void OnRoundTrip(Clock::duration rtt);
+
+        /**
+         * @brief 폴링 한 번마다 호출합니다. 직전 호출 이후의 트래픽으로 다음 주기를 정합니다.
+         * @param window 동시에 응답을 기다릴 수 있는 요청 수
+         */
+        std::chrono::microseconds Update(Clock::time_point now, int window);
+
+        /// 측정을 지우고 주기를 period로 되돌립니다.
+        void Reset(std::chrono::microseconds period);
+
+        std::chrono::microseconds Period() const { return period; }
+        /// 직전 Update() 구간에서 측정한 링크 사용률 (0.0 ~)
+        double Utilization() const { return utilization; }
+        double RoundTripUs() const { return rtt_us; }
+        double BytesPerPoll() const { return bytes_per_poll; }
+        bool OverBudget() const { return over_budget; }
+
+    private:
+        int baud_rate{1000000};
+        double target_utilization{DefaultTargetUtilization};
+        std::chrono::milliseconds staleness_budget{DefaultStalenessBudget};
+
+        uint64_t tx_bytes{0};
+        uint64_t rx_bytes{0};
+        Clock::time_point last_update{};
+        bool has_last_update{false};
+
+        uint64_t rtt_samples{0};
+        uint64_t poll_samples{0};
+        double bytes_per_poll{0.0}; // EWMA
+        double rtt_us{0.0};         // EWMA
+        double utilization{0.0};
+        bool over_budget{false};
+        std::chrono::microseconds period{std::chrono::milliseconds{50}};
+    };
+
+}
+#endif
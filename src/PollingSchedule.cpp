@@ -0,0 +1,186 @@
+#include "PollingSchedule.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "FrameEncoder.hpp"
+#include "RequestPipeline.hpp"
+
+namespace rc
+{
+
+    namespace
+    {
+        constexpr double BitsPerByte = 10.0;       // 8N1
+        constexpr std::size_t MaxHyperperiod = 4096; // phase 배치를 계산할 최대 틱 수
+        constexpr double RoundingSlack = 1e-9;       // 1000 / (50 Hz * 20 ms) 같은 나눗셈 오차를 올림하지 않도록
+
+        /// 양자화는 항상 올림합니다. 주기가 길어지는 쪽이므로 요청/예산보다 자주 폴링하지 않습니다.
+        double CeilQuantize(double value)
+        {
+            return std::ceil(value * (1.0 - RoundingSlack));
+        }
+
+        /// 응답 프레임 크기: FE FE LEN CMD payload FA
+        constexpr std::size_t ResponseFrameSize(std::size_t payload)
+        {
+            return payload + 5;
+        }
+
+        double Utilization(const std::vector<PollingSchedule::Slot> &entries, double byte_time_s)
+        {
+            double utilization = 0.0;
+            for (const PollingSchedule::Slot &slot : entries)
+            {
+                utilization += slot.entry.rate_hz * static_cast<double>(WireBytes(slot.entry.type)) * byte_time_s;
+            }
+            return utilization;
+        }
+    }
+
+    std::size_t WireBytes(RequestType request_type)
+    {
+        switch (request_type)
+        {
+        case RequestType::REQ_Angles:
+            return frames::GetAngles::FrameSize + ResponseFrameSize(12);
+        case RequestType::REQ_Coords:
+            return frames::GetCoords::FrameSize + ResponseFrameSize(12);
+        case RequestType::REQ_Speeds:
+            return frames::GetServoSpeeds::FrameSize + ResponseFrameSize(12);
+        case RequestType::REQ_Loads:
+            return frames::GetServoData16::FrameSize + ResponseFrameSize(2);
+        case RequestType::REQ_LoadSweep:
+            return Joints * WireBytes(RequestType::REQ_Loads);
+        case RequestType::REQ_IsMoving:
+            return frames::CheckRunning::FrameSize + ResponseFrameSize(1);
+        case RequestType::REQ_Voltages:
+            return frames::GetServoVoltages::FrameSize + ResponseFrameSize(6);
+        case RequestType::REQ_Encoders:
+            return frames::GetEncoders::FrameSize + ResponseFrameSize(12);
+        case RequestType::REQ_Speed:
+            return frames::GetSpeed::FrameSize + ResponseFrameSize(1);
+        case RequestType::REQ_IsPowerOn:
+            return frames::IsPoweredOn::FrameSize + ResponseFrameSize(1);
+        case RequestType::REQ_IsProgramPaused:
+            return frames::IsProgramPaused::FrameSize + ResponseFrameSize(1);
+        case RequestType::REQ_IsInPosition:
+            return frames::IsInPositionCoords::FrameSize + ResponseFrameSize(1);
+        case RequestType::REQ_IsServoEnabled:
+            return frames::IsServoEnabled::FrameSize + ResponseFrameSize(2);
+        case RequestType::REQ_IsAllServoEnabled:
+            return frames::IsAllServoEnabled::FrameSize + ResponseFrameSize(1);
+        default:
+            return ResponseFrameSize(0) * 2;
+        }
+    }
+
+    std::chrono::milliseconds PollingSchedule::AdaptiveTick(std::chrono::microseconds period, std::chrono::milliseconds staleness_budget)
+    {
+        return std::clamp(std::chrono::ceil<std::chrono::milliseconds>(period), MinTick, std::max(MinTick, staleness_budget));
+    }
+
+    void PollingSchedule::Compile(const std::vector<PollingEntry> &plan, std::chrono::milliseconds max_tick,
+                                  int baud_rate, double link_budget)
+    {
+        entries.clear();
+        degraded = false;
+        for (const PollingEntry &entry : plan)
+        {
+            if (std::isfinite(entry.rate_hz) && entry.rate_hz > 0.0)
+            {
+                Slot slot;
+                slot.entry = entry;
+                slot.requested_hz = entry.rate_hz;
+                entries.push_back(slot);
+            }
+        }
+        const double byte_time_s = BitsPerByte / static_cast<double>(std::max(baud_rate, 1));
+
+        // 1. 링크 예산을 넘으면 낮은 우선순위부터 주파수를 줄입니다.
+        double utilization = Utilization(entries, byte_time_s);
+        for (std::size_t p = RequestPriorityCount; p-- > 0 && utilization > link_budget;)
+        {
+            const auto priority = static_cast<RequestPriority>(p);
+            double priority_utilization = 0.0;
+            for (const Slot &slot : entries)
+            {
+                if (PriorityOf(slot.entry.type) == priority)
+                {
+                    priority_utilization += slot.entry.rate_hz * static_cast<double>(WireBytes(slot.entry.type)) * byte_time_s;
+                }
+            }
+            if (priority_utilization <= 0.0)
+            {
+                continue;
+            }
+            const double factor = std::max(0.0, (priority_utilization - (utilization - link_budget)) / priority_utilization);
+            for (Slot &slot : entries)
+            {
+                if (PriorityOf(slot.entry.type) == priority)
+                {
+                    slot.entry.rate_hz = std::max(slot.entry.rate_hz * factor, MinRateHz);
+                }
+            }
+            degraded = true;
+            utilization = Utilization(entries, byte_time_s);
+        }
+
+        // 2. 기본 틱은 가장 높은 주파수의 주기를 ms 단위로 올림한 값 (max_tick 이하)
+        double max_rate = 0.0;
+        for (const Slot &slot : entries)
+        {
+            max_rate = std::max(max_rate, slot.entry.rate_hz);
+        }
+        tick = max_tick;
+        if (max_rate > 0.0)
+        {
+            tick = std::min(tick, std::chrono::milliseconds{static_cast<int64_t>(CeilQuantize(1000.0 / max_rate))});
+        }
+        tick = std::max(tick, MinTick);
+        const double tick_ms = static_cast<double>(tick.count());
+
+        // 3. 각 항목의 divisor(올림)와 실제 주파수. 실제 주파수는 1단계의 주파수를 넘지 않습니다.
+        std::size_t hyperperiod = 1;
+        for (Slot &slot : entries)
+        {
+            slot.divisor = static_cast<uint32_t>(std::max(1.0, CeilQuantize(1000.0 / (slot.entry.rate_hz * tick_ms))));
+            slot.entry.rate_hz = 1000.0 / (static_cast<double>(slot.divisor) * tick_ms);
+            hyperperiod = std::min(std::lcm(hyperperiod, static_cast<std::size_t>(slot.divisor)), MaxHyperperiod);
+        }
+
+        // 4. 자주 보내는 항목부터, 한 틱에 몰리는 바이트가 가장 적은 phase를 고릅니다.
+        std::vector<std::size_t> order(entries.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b)
+                         { return entries[a].divisor < entries[b].divisor; });
+        std::vector<std::size_t> load(hyperperiod, 0);
+        for (const std::size_t index : order)
+        {
+            Slot &slot = entries[index];
+            const std::size_t bytes = WireBytes(slot.entry.type);
+            std::size_t best_peak = SIZE_MAX;
+            for (uint32_t phase = 0; phase < slot.divisor; ++phase)
+            {
+                std::size_t peak = 0;
+                for (std::size_t k = phase; k < hyperperiod; k += slot.divisor)
+                {
+                    peak = std::max(peak, load[k]);
+                }
+                if (peak < best_peak)
+                {
+                    best_peak = peak;
+                    slot.phase = phase;
+                }
+            }
+            for (std::size_t k = slot.phase; k < hyperperiod; k += slot.divisor)
+            {
+                load[k] += bytes;
+            }
+        }
+
+        estimated_utilization = Utilization(entries, byte_time_s);
+    }
+
+}
@@ -0,0 +1,79 @@
+#ifndef ROBOSIGNAL_POLLINGSCHEDULE_HPP
+#define ROBOSIGNAL_POLLINGSCHEDULE_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MyCobot.hpp"
+
+namespace rc
+{
+
+    /// 요청 1회의 선로 바이트 (요청 프레임 + 응답 프레임)
+    std::size_t WireBytes(RequestType request_type);
+
+    /**
+     * @brief 폴링 계획(요청, 관절, 주파수)을 고정 틱 스케줄로 컴파일합니다.
+     *
+     * 기본 틱은 가장 높은 주파수의 주기(ms 단위로 올림)와 max_tick 중 작은 값입니다. 각 항목은
+     * "divisor 틱마다, phase번째 틱에" 요청되며, phase는 한 틱에 몰리는 바이트가
+     * 가장 적도록 고릅니다. 예상 링크 사용률이 link_budget을 넘으면 우선순위가
+     * 낮은 항목(진단 → 텔레메트리 → 동작)부터 주파수를 낮춥니다.
+     * 틱과 divisor는 올림으로 양자화하므로, 컴파일된 주파수는 계획의 주파수(예산 때문에 낮췄다면
+     * 낮춘 주파수)를 넘지 않습니다. 예: 300 Hz -> 4 ms 틱 -> 250 Hz
+     */
+    class PollingSchedule
+    {
+    public:
+        static constexpr std::chrono::milliseconds MinTick{2};
+        static constexpr double MinRateHz = 0.1;
+
+        struct Slot
+        {
+            PollingEntry entry{};       // rate_hz는 실제 적용되는 주파수
+            double requested_hz{0.0};   // 계획에 적힌 주파수
+            uint32_t divisor{1};
+            uint32_t phase{0};
+        };
+
+        void Compile(const std::vector<PollingEntry> &plan, std::chrono::milliseconds max_tick,
+                     int baud_rate, double link_budget);
+
+        /**
+         * @brief 적응형 폴링의 틱 간격: PollRateController가 정한 주기(ms 단위로 올림)를 MinTick ~ staleness_budget으로 제한합니다.
+         * 컴파일된 Tick()과 무관하므로 더 짧을 수 있으며, 그때는 각 항목이 divisor 틱마다 계획보다 자주 요청됩니다.
+         */
+        static std::chrono::milliseconds AdaptiveTick(std::chrono::microseconds period, std::chrono::milliseconds staleness_budget);
+
+        std::chrono::milliseconds Tick() const { return tick; }
+        const std::vector<Slot> &Entries() const { return entries; }
+        bool Empty() const { return entries.empty(); }
+        /// 컴파일된 스케줄의 예상 링크 사용률 (0.0 ~)
+        double EstimatedUtilization() const { return estimated_utilization; }
+        /// 링크 예산 때문에 주파수를 낮춘 항목이 있으면 true
+        bool Degraded() const { return degraded; }
+
+        /// tick번째 틱에 보낼 요청마다 fn(const PollingEntry &)을 호출합니다.
+        template <typename Fn>
+        void ForEachDue(uint64_t tick_index, Fn &&fn) const
+        {
+            for (const Slot &slot : entries)
+            {
+                if (tick_index % slot.divisor == slot.phase)
+                {
+                    fn(slot.entry);
+                }
+            }
+        }
+
+    private:
+        std::vector<Slot> entries{};
+        std::chrono::milliseconds tick{50};
+        double estimated_utilization{0.0};
+        bool degraded{false};
+    };
+
+}
+#endif
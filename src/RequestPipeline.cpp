@@ -0,0 +1,344 @@
+#include "RequestPipeline.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+#include "Firmata.hpp"
+
+namespace rc
+{
+
+    unsigned char ResponseCommand(RequestType request_type)
+    {
+        switch (request_type)
+        {
+        case RequestType::REQ_Angles:
+            return Command::GetAngles;
+        case RequestType::REQ_Coords:
+            return Command::GetCoords;
+        case RequestType::REQ_Speeds:
+            return Command::GET_SERVO_SPEEDS;
+        case RequestType::REQ_Loads:
+        case RequestType::REQ_LoadSweep:
+            return Command::GetServoData;
+        case RequestType::REQ_IsMoving:
+            return Command::CheckRunning;
+        case RequestType::REQ_Voltages:
+            return Command::GET_SERVO_VOLTAGES;
+        case RequestType::REQ_Encoders:
+            return Command::GetEncoders;
+        case RequestType::REQ_Speed:
+            return Command::GetSpeed;
+        case RequestType::REQ_IsPowerOn:
+            return Command::IsPoweredOn;
+        case RequestType::REQ_IsProgramPaused:
+            return Command::IsProgramPaused;
+        case RequestType::REQ_IsInPosition:
+            return Command::IsInPosition;
+        case RequestType::REQ_IsServoEnabled:
+            return Command::IsServoEnabled;
+        case RequestType::REQ_IsAllServoEnabled:
+            return Command::IsAllServoEnabled;
+        default:
+            return Command::Undefined;
+        }
+    }
+
+    bool RequestTypeOf(unsigned char command, RequestType &request_type)
+    {
+        if (command == Command::Undefined)
+        {
+            return false;
+        }
+        for (int type = static_cast<int>(RequestType::REQ_Angles); type <= static_cast<int>(RequestType::REQ_IsAllServoEnabled); ++type)
+        {
+            if (ResponseCommand(static_cast<RequestType>(type)) == command)
+            {
+                request_type = static_cast<RequestType>(type);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool HasAmbiguousReply(unsigned char command)
+    {
+        return command == Command::GetServoData;
+    }
+
+    RequestPriority PriorityOf(RequestType request_type)
+    {
+        switch (request_type)
+        {
+        case RequestType::REQ_IsMoving:
+        case RequestType::REQ_Angles:
+        case RequestType::REQ_Coords:
+        case RequestType::REQ_Encoders:
+        case RequestType::REQ_Speed:
+        case RequestType::REQ_IsPowerOn:
+        case RequestType::REQ_IsProgramPaused:
+        case RequestType::REQ_IsInPosition:
+        case RequestType::REQ_IsServoEnabled:
+        case RequestType::REQ_IsAllServoEnabled:
+            return RequestPriority::Motion;
+        case RequestType::REQ_Speeds:
+        case RequestType::REQ_Loads:
+        case RequestType::REQ_LoadSweep:
+            return RequestPriority::Telemetry;
+        case RequestType::REQ_Voltages:
+            return RequestPriority::Diagnostics;
+        default:
+            return RequestPriority::Diagnostics;
+        }
+    }
+
+    void RequestPipeline::SetWindow(int window_)
+    {
+        window = std::clamp(window_, 1, MaxWindow);
+    }
+
+    void RequestPipeline::SetTimeout(std::chrono::milliseconds timeout_)
+    {
+        timeout = std::max(timeout_, std::chrono::milliseconds{1});
+    }
+
+    void RequestPipeline::SetMaxRetries(int max_retries_)
+    {
+        max_retries = std::max(max_retries_, 0);
+    }
+
+    void RequestPipeline::SetMaxDepth(int max_depth_)
+    {
+        max_depth = std::max(max_depth_, 1);
+    }
+
+    std::size_t RequestPipeline::QueuedCount() const
+    {
+        std::size_t total = 0;
+        for (const auto &queue : queues)
+        {
+            total += queue.size();
+        }
+        return total;
+    }
+
+    EnqueueResult RequestPipeline::Enqueue(RequestType request_type, Joint joint, uint32_t query_id)
+    {
+        return Insert({request_type, joint, 0, query_id}, false);
+    }
+
+    EnqueueResult RequestPipeline::Insert(const QueuedRequest &request, bool at_front)
+    {
+        const auto priority = static_cast<std::size_t>(PriorityOf(request.type));
+        auto &queue = queues[priority];
+
+        // 같은 요청이 이미 대기 중이면 한 번만 보내도 최신 값을 받습니다.
+        const bool duplicate = request.query_id == 0 &&
+                               std::any_of(queue.begin(), queue.end(),
+                                           [&request](const QueuedRequest &queued)
+                                           { return queued.query_id == 0 && queued.type == request.type && queued.joint == request.joint; });
+        if (duplicate)
+        {
+            ++merged;
+            return EnqueueResult::Merged;
+        }
+
+        if (IsSaturated())
+        {
+            // 더 낮은 우선순위의 가장 오래된 요청을 밀어냅니다.
+            std::size_t victim = RequestPriorityCount;
+            for (std::size_t p = RequestPriorityCount; p-- > priority + 1;)
+            {
+                if (!queues[p].empty())
+                {
+                    victim = p;
+                    break;
+                }
+            }
+            if (victim == RequestPriorityCount)
+            {
+                ++rejected;
+                return EnqueueResult::Rejected;
+            }
+            queues[victim].pop_front();
+            ++evicted;
+        }
+
+        if (at_front)
+        {
+            queue.push_front(request);
+        }
+        else
+        {
+            queue.push_back(request);
+        }
+        return EnqueueResult::Queued;
+    }
+
+    bool RequestPipeline::Dispatch(Clock::time_point now, PendingRequest &request)
+    {
+        if (in_flight.size() >= static_cast<std::size_t>(window))
+        {
+            return false;
+        }
+        // 높은 우선순위부터, 지금 보낼 수 있는 가장 오래된 요청 (응답이 모호한 요청은 하나씩만)
+        std::deque<QueuedRequest> *queue = nullptr;
+        std::deque<QueuedRequest>::iterator it;
+        for (auto &candidates : queues)
+        {
+            it = std::find_if(candidates.begin(), candidates.end(), [this, now](const QueuedRequest &queued)
+                              { return !IsAmbiguousBusy(ResponseCommand(queued.type), now); });
+            if (it != candidates.end())
+            {
+                queue = &candidates;
+                break;
+            }
+        }
+        if (!queue)
+        {
+            return false;
+        }
+        const QueuedRequest next = *it;
+        queue->erase(it);
+
+        request.type = next.type;
+        request.joint = next.joint;
+        request.command = ResponseCommand(next.type);
+        request.attempt = next.attempt;
+        request.query_id = next.query_id;
+        request.sent_at = now;
+        request.deadline = now + timeout;
+        in_flight.push_back(request);
+        return true;
+    }
+
+    bool RequestPipeline::TrackExternal(RequestType request_type, Joint joint, Clock::time_point now, std::chrono::milliseconds timeout_)
+    {
+        const unsigned char command = ResponseCommand(request_type);
+        if (IsAmbiguousBusy(command, now))
+        {
+            return false;
+        }
+        PendingRequest request;
+        request.type = request_type;
+        request.joint = joint;
+        request.command = command;
+        request.external = true;
+        request.sent_at = now;
+        request.deadline = now + timeout_;
+        in_flight.push_back(request);
+        return true;
+    }
+
+    bool RequestPipeline::TrackReplayed(unsigned char command, Joint joint, Clock::time_point now)
+    {
+        PendingRequest request;
+        if (!RequestTypeOf(command, request.type))
+        {
+            return false;
+        }
+        request.joint = joint;
+        request.command = command;
+        request.sent_at = now;
+        request.deadline = now + timeout;
+        in_flight.push_back(request);
+        return true;
+    }
+
+    void RequestPipeline::CancelLastDispatch()
+    {
+        if (!in_flight.empty())
+        {
+            in_flight.pop_back();
+        }
+    }
+
+    bool RequestPipeline::Complete(unsigned char command, PendingRequest &matched)
+    {
+        auto it = std::find_if(in_flight.begin(), in_flight.end(),
+                               [command](const PendingRequest &request)
+                               { return request.command == command; });
+        if (it == in_flight.end())
+        {
+            return false;
+        }
+        matched = *it;
+        in_flight.erase(it);
+        ++completed;
+        return true;
+    }
+
+    std::size_t RequestPipeline::ExpireTimedOut(Clock::time_point now, std::vector<PendingRequest> *dropped_requests)
+    {
+        auto first_expired = std::stable_partition(in_flight.begin(), in_flight.end(),
+                                                   [now](const PendingRequest &request)
+                                                   { return request.deadline > now; });
+        const std::size_t expired = static_cast<std::size_t>(std::distance(first_expired, in_flight.end()));
+
+        const std::size_t dropped_begin = dropped_requests ? dropped_requests->size() : 0;
+        // 재시도는 새 요청보다 먼저 나가도록 대기열 앞에 넣습니다. 역순으로 넣어 원래 순서를 유지합니다.
+        for (auto it = in_flight.rbegin(); it != in_flight.rbegin() + static_cast<std::ptrdiff_t>(expired); ++it)
+        {
+            if (HasAmbiguousReply(it->command))
+            {
+                // 이 요청의 응답이 늦게 올 수 있으므로 타임아웃 한 번 동안 같은 명령어를 보내지 않습니다.
+                resync_until = now + timeout;
+                ++resyncs;
+            }
+            // 대기열이 가득 차서 다시 넣지 못한 요청은 버린 것으로 셉니다.
+            if (!it->external && it->attempt < max_retries &&
+                Insert({it->type, it->joint, it->attempt + 1, it->query_id}, true) != EnqueueResult::Rejected)
+            {
+                ++retried;
+            }
+            else
+            {
+                ++dropped;
+                if (dropped_requests)
+                {
+                    dropped_requests->push_back(*it);
+                }
+            }
+        }
+        if (dropped_requests)
+        {
+            // 역순으로 모았으므로 보낸 순서로 되돌립니다.
+            std::reverse(dropped_requests->begin() + static_cast<std::ptrdiff_t>(dropped_begin), dropped_requests->end());
+        }
+        in_flight.erase(first_expired, in_flight.end());
+        timed_out += expired;
+        return expired;
+    }
+
+    bool RequestPipeline::NextDeadline(Clock::time_point &deadline) const
+    {
+        bool found = false;
+        if (!in_flight.empty())
+        {
+            deadline = std::min_element(in_flight.begin(), in_flight.end(),
+                                        [](const PendingRequest &a, const PendingRequest &b)
+                                        { return a.deadline < b.deadline; })
+                           ->deadline;
+            found = true;
+        }
+        // 재동기화가 끝나면 미뤄 둔 요청을 보내야 하므로 그 시각에도 깨웁니다.
+        if (resync_until > Clock::now() && QueuedCount() > 0 && (!found || resync_until < deadline))
+        {
+            deadline = resync_until;
+            found = true;
+        }
+        return found;
+    }
+
+    bool RequestPipeline::IsAmbiguousBusy(unsigned char command, Clock::time_point now) const
+    {
+        if (!HasAmbiguousReply(command))
+        {
+            return false;
+        }
+        return now < resync_until ||
+               std::any_of(in_flight.begin(), in_flight.end(), [command](const PendingRequest &request)
+                           { return request.command == command; });
+    }
+
+}
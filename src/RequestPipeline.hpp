@@ -0,0 +1,188 @@
+#ifndef ROBOSIGNAL_REQUESTPIPELINE_HPP
+#define ROBOSIGNAL_REQUESTPIPELINE_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "MyCobot.hpp"
+
+namespace rc
+{
+
+    /// 전송되어 응답을 기다리는 요청
+    struct PendingRequest
+    {
+        RequestType type{RequestType::REQ_Angles};
+        Joint joint{J1};
+        unsigned char command{0}; // 응답으로 돌아올 명령어 ID
+        int attempt{0};           // 재전송 횟수 (처음 전송은 0)
+        uint32_t query_id{0};     // 비동기 조회 ID (0이면 일반 요청)
+        bool external{false};     // 대기열을 거치지 않고 직접 보낸 요청 (TrackExternal)
+        std::chrono::steady_clock::time_point sent_at{};
+        std::chrono::steady_clock::time_point deadline{};
+    };
+
+    /// 요청 타입에 대한 응답 명령어 ID
+    unsigned char ResponseCommand(RequestType request_type);
+
+    /// 응답 명령어 ID가 command인 요청 타입. 조회 명령어가 아니면 false
+    bool RequestTypeOf(unsigned char command, RequestType &request_type);
+
+    /// 응답에 요청을 구별할 정보가 없는 명령어이면 true (GetServoData: 응답에 관절 번호가 없음)
+    bool HasAmbiguousReply(unsigned char command);
+
+    /// 요청 우선순위 (값이 작을수록 먼저 보냄)
+    enum class RequestPriority
+    {
+        Motion,      // 동작 상태: IsMoving, Angles, Coords, 그리고 비동기 조회
+        Telemetry,   // 관절 텔레메트리: Speeds, Loads
+        Diagnostics, // 진단: Voltages
+    };
+    constexpr std::size_t RequestPriorityCount = 3;
+
+    RequestPriority PriorityOf(RequestType request_type);
+
+    /// Enqueue() 결과
+    enum class EnqueueResult
+    {
+        Queued,   // 새로 대기열에 추가됨
+        Merged,   // 같은 요청이 이미 대기 중이어서 합쳐짐
+        Rejected, // 대기열이 가득 차서 거부됨
+    };
+
+    /**
+     * @brief 동시에 여러 요청을 보내는 스케줄러 (in-flight window).
+     *
+     * 대기열의 요청은 window 개수까지 응답을 기다리지 않고 전송됩니다.
+     * 응답은 명령어 ID가 같은 가장 오래된 in-flight 요청과 짝지어집니다(FIFO).
+     * 각 요청은 deadline을 가지며, 지나면 ExpireTimedOut()에서 제거됩니다.
+     * 타임아웃된 요청은 재시도 횟수가 남아 있으면 대기열 맨 앞에 다시 넣고,
+     * 아니면 버립니다. 두 경우 모두 카운터에 기록됩니다.
+     *
+     * 대기열은 우선순위별로 나뉘며, 높은 우선순위부터 보냅니다. 같은 타입/관절의
+     * 요청이 이미 대기 중이면 새로 넣지 않고 합칩니다. 대기열 길이가 MaxDepth()에
+     * 이르면 더 낮은 우선순위의 가장 오래된 요청을 밀어내고, 그런 요청이 없으면
+     * 새 요청을 거부합니다 (backpressure).
+     *
+     * query_id가 있는 요청(비동기 조회)은 각자 결과를 기다리므로 합치지 않습니다.
+     *
+     * 응답만으로 요청을 구별할 수 없는 명령어(HasAmbiguousReply)는 한 번에 하나만 in-flight로 둡니다.
+     * 그런 요청이 타임아웃되면 늦게 온 응답이 다음 요청의 것으로 짝지어지지 않도록, 타임아웃 한 번 동안
+     * 같은 명령어를 보내지 않는 재동기화 구간을 둡니다. 이 구간의 응답은 짝이 없으므로 버려야 합니다.
+     */
+    class RequestPipeline
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr int DefaultWindow = 3;
+        static constexpr int MaxWindow = 16;
+        static constexpr std::chrono::milliseconds DefaultTimeout{100};
+        static constexpr int DefaultMaxRetries = 1;
+        static constexpr int DefaultMaxDepth = 32;
+
+        void SetWindow(int window);
+        int Window() const { return window; }
+        void SetTimeout(std::chrono::milliseconds timeout);
+        std::chrono::milliseconds Timeout() const { return timeout; }
+        /// 타임아웃된 요청을 다시 보낼 최대 횟수 (0이면 바로 버림)
+        void SetMaxRetries(int max_retries);
+        int MaxRetries() const { return max_retries; }
+        /// 대기열 최대 길이 (in-flight 제외)
+        void SetMaxDepth(int max_depth);
+        int MaxDepth() const { return max_depth; }
+
+        EnqueueResult Enqueue(RequestType request_type, Joint joint, uint32_t query_id = 0);
+        /// 대기열이 가득 차 있으면 true
+        bool IsSaturated() const { return QueuedCount() >= static_cast<std::size_t>(max_depth); }
+
+        /**
+         * @brief window에 여유가 있으면 다음 요청을 꺼내 in-flight로 옮깁니다.
+         * @return 보낼 요청이 있으면 true
+         */
+        bool Dispatch(Clock::time_point now, PendingRequest &request);
+
+        /**
+         * @brief 대기열을 거치지 않고 직접 보낼 요청을 in-flight로 등록합니다. (동기 GetServoData 등)
+         * 응답이 모호한 명령어가 이미 in-flight이거나 재동기화 중이면 등록하지 않고 false를 반환합니다.
+         * window와 무관하게 등록되며, 전송에 실패하면 CancelLastDispatch()로 되돌립니다.
+         */
+        bool TrackExternal(RequestType request_type, Joint joint, Clock::time_point now, std::chrono::milliseconds timeout_);
+
+        /**
+         * @brief 캡처를 재생할 때 기록된 송신 프레임을 in-flight로 등록합니다. (ReplaySerialCapture)
+         * 실제로 보낸 요청이므로 window, 재동기화와 무관하게 등록합니다. 응답이 없는 명령어(동작 명령 등)이면
+         * 등록하지 않고 false를 반환합니다. deadline은 now + Timeout()입니다.
+         */
+        bool TrackReplayed(unsigned char command, Joint joint, Clock::time_point now);
+
+        /// 전송에 실패한 마지막 Dispatch()를 되돌립니다.
+        void CancelLastDispatch();
+
+        /**
+         * @brief 수신한 응답을 in-flight 요청과 짝짓습니다.
+         * @return 짝지어진 요청이 있으면 true, matched에 해당 요청을 채웁니다.
+         */
+        bool Complete(unsigned char command, PendingRequest &matched);
+
+        /**
+         * @brief deadline이 지난 in-flight 요청을 재시도 대기열로 옮기거나 버리고, 그 개수를 반환합니다.
+         * @param dropped_requests nullptr가 아니면 버린 요청을 뒤에 덧붙입니다.
+         */
+        std::size_t ExpireTimedOut(Clock::time_point now, std::vector<PendingRequest> *dropped_requests = nullptr);
+
+        /// 가장 이른 in-flight deadline (재동기화 구간의 끝 포함). 기다릴 것이 없으면 false
+        bool NextDeadline(Clock::time_point &deadline) const;
+
+        /**
+         * @brief 응답이 모호한 command를 지금 보낼 수 없으면 true (같은 명령어가 in-flight이거나 재동기화 중)
+         * 다른 명령어는 항상 false입니다.
+         */
+        bool IsAmbiguousBusy(unsigned char command, Clock::time_point now) const;
+        /// 응답이 모호한 요청이 타임아웃되어 재동기화를 시작한 횟수
+        uint64_t ResyncCount() const { return resyncs; }
+
+        std::size_t QueuedCount() const;
+        std::size_t InFlightCount() const { return in_flight.size(); }
+        uint64_t CompletedCount() const { return completed; }
+        uint64_t TimedOutCount() const { return timed_out; }
+        uint64_t RetriedCount() const { return retried; }
+        uint64_t DroppedCount() const { return dropped; }
+        uint64_t MergedCount() const { return merged; }
+        uint64_t RejectedCount() const { return rejected; }
+        uint64_t EvictedCount() const { return evicted; }
+
+    private:
+        struct QueuedRequest
+        {
+            RequestType type;
+            Joint joint;
+            int attempt;
+            uint32_t query_id;
+        };
+
+        EnqueueResult Insert(const QueuedRequest &request, bool at_front);
+
+        std::array<std::deque<QueuedRequest>, RequestPriorityCount> queues{};
+        std::deque<PendingRequest> in_flight{};
+        int window{DefaultWindow};
+        std::chrono::milliseconds timeout{DefaultTimeout};
+        int max_retries{DefaultMaxRetries};
+        int max_depth{DefaultMaxDepth};
+        uint64_t completed{0};
+        uint64_t timed_out{0};
+        uint64_t retried{0};
+        uint64_t dropped{0};
+        uint64_t merged{0};
+        uint64_t rejected{0};
+        uint64_t evicted{0};
+        uint64_t resyncs{0};
+        Clock::time_point resync_until{}; // 이 시각까지 응답이 모호한 명령어를 보내지 않습니다.
+    };
+
+}
+#endif
@@ -0,0 +1,81 @@
+#ifndef ROBOSIGNAL_SEQLOCK_HPP
+#define ROBOSIGNAL_SEQLOCK_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace rc
+{
+
+    /**
+     * @brief 단일 쓰기/다중 읽기 seqlock.
+     *
+     * Store()는 한 스레드에서만 호출해야 하고, Load()는 어느 스레드에서나 락 없이 호출할 수 있습니다.
+     * 읽는 도중에 쓰기가 끼어들면 시퀀스 번호가 달라지므로 다시 읽어, 항상 한 번의 Store()로
+     * 쓰인 값 전체를 돌려줍니다. 값은 atomic 워드 배열에 복사해 두므로 읽기/쓰기가 겹쳐도
+     * 데이터 경합(undefined behavior)이 아닙니다. 쓰기 쪽은 기다리지 않습니다.
+     */
+    template <typename T>
+    class SeqLock
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "SeqLock value must be trivially copyable");
+
+        static constexpr std::size_t WordCount = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    public:
+        SeqLock() { Store(T{}); }
+        explicit SeqLock(const T &value) { Store(value); }
+
+        SeqLock(const SeqLock &) = delete;
+        SeqLock &operator=(const SeqLock &) = delete;
+
+        void Store(const T &value)
+        {
+            std::array<uint64_t, WordCount> words{};
+            std::memcpy(words.data(), &value, sizeof(T));
+
+            const uint64_t seq = sequence.load(std::memory_order_relaxed);
+            sequence.store(seq + 1, std::memory_order_relaxed); // 홀수: 쓰는 중
+            std::atomic_thread_fence(std::memory_order_release);
+            for (std::size_t i = 0; i < WordCount; ++i)
+            {
+                storage[i].store(words[i], std::memory_order_relaxed);
+            }
+            sequence.store(seq + 2, std::memory_order_release);
+        }
+
+        T Load() const
+        {
+            std::array<uint64_t, WordCount> words{};
+            uint64_t before = 0;
+            uint64_t after = 0;
+            do
+            {
+                before = sequence.load(std::memory_order_acquire);
+                for (std::size_t i = 0; i < WordCount; ++i)
+                {
+                    words[i] = storage[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                after = sequence.load(std::memory_order_relaxed);
+            } while ((before & 1u) != 0 || before != after);
+
+            T value;
+            std::memcpy(static_cast<void *>(&value), words.data(), sizeof(T));
+            return value;
+        }
+
+        /// 지금까지 완료된 Store() 횟수
+        uint64_t Version() const { return sequence.load(std::memory_order_acquire) / 2; }
+
+    private:
+        alignas(64) std::atomic<uint64_t> sequence{0};
+        std::array<std::atomic<uint64_t>, WordCount> storage{};
+    };
+
+}
+#endif
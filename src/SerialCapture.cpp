@@ -0,0 +1,138 @@
+#include "SerialCapture.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+namespace rc
+{
+
+    namespace
+    {
+        constexpr std::size_t WriteBufferSize = 64 * 1024;
+        constexpr uint32_t TxFlag = 0x80000000u;
+        constexpr uint32_t MaxRecordSize = 16 * 1024 * 1024; // 손상된 파일에서 터무니없는 할당을 막습니다.
+
+        int64_t ToNs(std::chrono::nanoseconds duration)
+        {
+            return static_cast<int64_t>(duration.count());
+        }
+    }
+
+    SerialCaptureWriter::~SerialCaptureWriter()
+    {
+        Close();
+    }
+
+    bool SerialCaptureWriter::Open(const std::string &path, std::string &error)
+    {
+        Close();
+        file = std::fopen(path.c_str(), "wb");
+        if (!file)
+        {
+            error = "Could not create " + path + ": " + std::strerror(errno);
+            return false;
+        }
+        buffer.resize(WriteBufferSize);
+        std::setvbuf(file, buffer.data(), _IOFBF, buffer.size());
+
+        start = std::chrono::steady_clock::now();
+        SerialCaptureHeader header;
+        header.start_steady_ns = ToNs(start.time_since_epoch());
+        header.start_system_ns = ToNs(std::chrono::system_clock::now().time_since_epoch());
+        records = 0;
+        bytes = 0;
+        if (std::fwrite(&header, sizeof(header), 1, file) != 1)
+        {
+            error = "Could not write " + path + ": " + std::strerror(errno);
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void SerialCaptureWriter::Close()
+    {
+        if (file)
+        {
+            std::fclose(file);
+            file = nullptr;
+        }
+    }
+
+    bool SerialCaptureWriter::Write(CaptureDirection direction, const char *data, std::size_t size,
+                                    std::chrono::steady_clock::time_point time)
+    {
+        if (!file || size == 0)
+        {
+            return file != nullptr;
+        }
+        const int64_t offset_ns = ToNs(time - start);
+        const uint32_t size_field = static_cast<uint32_t>(size) | (direction == CaptureDirection::Tx ? TxFlag : 0u);
+        if (std::fwrite(&offset_ns, sizeof(offset_ns), 1, file) != 1 ||
+            std::fwrite(&size_field, sizeof(size_field), 1, file) != 1 ||
+            std::fwrite(data, 1, size, file) != size)
+        {
+            return false;
+        }
+        ++records;
+        bytes += size;
+        return true;
+    }
+
+    SerialCaptureReader::~SerialCaptureReader()
+    {
+        Close();
+    }
+
+    bool SerialCaptureReader::Open(const std::string &path, std::string &error)
+    {
+        Close();
+        file = std::fopen(path.c_str(), "rb");
+        if (!file)
+        {
+            error = "Could not open " + path + ": " + std::strerror(errno);
+            return false;
+        }
+        if (std::fread(&header, sizeof(header), 1, file) != 1 || header.magic != SerialCaptureMagic ||
+            header.version != SerialCaptureVersion || header.byte_order != SerialCaptureHeader{}.byte_order)
+        {
+            error = "Not a serial capture file: " + path;
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void SerialCaptureReader::Close()
+    {
+        if (file)
+        {
+            std::fclose(file);
+            file = nullptr;
+        }
+        header = SerialCaptureHeader{};
+    }
+
+    bool SerialCaptureReader::Next(Record &record)
+    {
+        if (!file)
+        {
+            return false;
+        }
+        uint32_t size_field = 0;
+        if (std::fread(&record.offset_ns, sizeof(record.offset_ns), 1, file) != 1 ||
+            std::fread(&size_field, sizeof(size_field), 1, file) != 1)
+        {
+            return false;
+        }
+        const uint32_t size = size_field & ~TxFlag;
+        if (size > MaxRecordSize)
+        {
+            return false;
+        }
+        record.direction = (size_field & TxFlag) ? CaptureDirection::Tx : CaptureDirection::Rx;
+        record.data.resize(size);
+        return std::fread(record.data.data(), 1, size, file) == size;
+    }
+
+}
@@ -0,0 +1,102 @@
+#ifndef ROBOSIGNAL_SERIALCAPTURE_HPP
+#define ROBOSIGNAL_SERIALCAPTURE_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace rc
+{
+
+    /**
+     * 시리얼 캡처 파일 형식 (버전 1, 호스트 바이트 순서)
+     *
+     *   [SerialCaptureHeader] [레코드] [레코드] ...
+     *   레코드 = int64 offset_ns (캡처 시작부터) + uint32 (bit 31: 송신, 나머지: 바이트 수) + 바이트
+     *
+     * 수신 레코드는 시리얼 포트에서 읽은 덩어리 그대로이고, 송신 레코드는 SerialWrite() 프레임 하나입니다.
+     */
+    constexpr uint32_t SerialCaptureMagic = 0x50414352; // "RCAP"
+    constexpr uint32_t SerialCaptureVersion = 1;
+
+    struct SerialCaptureHeader
+    {
+        uint32_t magic{SerialCaptureMagic};
+        uint32_t version{SerialCaptureVersion};
+        int64_t start_steady_ns{0};
+        int64_t start_system_ns{0};
+        uint32_t byte_order{0x01020304};
+        uint32_t reserved{0};
+    };
+
+    enum class CaptureDirection : uint8_t
+    {
+        Rx,
+        Tx,
+    };
+
+    /**
+     * @brief 시리얼 송수신 바이트를 캡처 파일에 씁니다.
+     * 64 KiB stdio 버퍼에 모아 쓰므로 Write()는 대부분 메모리 복사만 합니다.
+     */
+    class SerialCaptureWriter
+    {
+    public:
+        SerialCaptureWriter() = default;
+        ~SerialCaptureWriter();
+
+        SerialCaptureWriter(const SerialCaptureWriter &) = delete;
+        SerialCaptureWriter &operator=(const SerialCaptureWriter &) = delete;
+
+        bool Open(const std::string &path, std::string &error);
+        void Close();
+        bool IsOpen() const { return file != nullptr; }
+
+        /// 쓰기에 실패하면 false (디스크 부족 등)
+        bool Write(CaptureDirection direction, const char *data, std::size_t size, std::chrono::steady_clock::time_point time);
+
+        uint64_t Records() const { return records; }
+        uint64_t Bytes() const { return bytes; }
+
+    private:
+        std::FILE *file{nullptr};
+        std::vector<char> buffer{};
+        std::chrono::steady_clock::time_point start{};
+        uint64_t records{0};
+        uint64_t bytes{0};
+    };
+
+    /// 캡처 파일을 처음부터 차례로 읽습니다.
+    class SerialCaptureReader
+    {
+    public:
+        struct Record
+        {
+            int64_t offset_ns{0}; // 캡처 시작부터
+            CaptureDirection direction{CaptureDirection::Rx};
+            std::vector<char> data{};
+        };
+
+        SerialCaptureReader() = default;
+        ~SerialCaptureReader();
+
+        SerialCaptureReader(const SerialCaptureReader &) = delete;
+        SerialCaptureReader &operator=(const SerialCaptureReader &) = delete;
+
+        bool Open(const std::string &path, std::string &error);
+        void Close();
+        const SerialCaptureHeader &Header() const { return header; }
+
+        /// 다음 레코드를 읽습니다. 파일 끝이거나 마지막 레코드가 잘려 있으면 false
+        bool Next(Record &record);
+
+    private:
+        std::FILE *file{nullptr};
+        SerialCaptureHeader header{};
+    };
+
+}
+#endif
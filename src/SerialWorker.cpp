@@ -0,0 +1,186 @@
+#include "SerialWorker.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <QMetaObject>
+
+#define log_category ::rc::log::robot_controller
+#include "log/Log.hpp"
+
+namespace rc
+{
+
+    SerialWorker::SerialWorker(std::function<void()> notify)
+        : QObject(nullptr),
+          notify_rx(std::move(notify))
+    {
+        tx_buffer.reserve(static_cast<int>(TxQueueSize * PacketDecoder::MaxPacketSize));
+    }
+
+    SerialWorker::~SerialWorker() = default;
+
+    bool SerialWorker::Open(const QString &port_name, int baud_rate,
+                            QSerialPort::SerialPortError &error, QString &error_string)
+    {
+        bool opened = false;
+        // QSerialPort는 워커 스레드에서 생성/사용해야 하므로 해당 스레드에서 실행될 때까지 기다립니다.
+        QMetaObject::invokeMethod(
+            this, [&]()
+            {
+                if (!serial_port)
+                {
+                    serial_port = new QSerialPort(this);
+                    connect(serial_port, &QSerialPort::readyRead, this, &SerialWorker::HandleReadyRead);
+                    connect(serial_port, &QSerialPort::bytesWritten, this, &SerialWorker::HandleBytesWritten);
+                    connect(serial_port, &QSerialPort::errorOccurred, this, &SerialWorker::errorOccurred);
+                }
+                if (serial_port->isOpen())
+                {
+                    opened = true;
+                    return;
+                }
+                serial_port->setPortName(port_name);
+                serial_port->setBaudRate(baud_rate);
+                opened = serial_port->open(QIODevice::ReadWrite);
+                if (!opened)
+                {
+                    error = serial_port->error();
+                    error_string = serial_port->errorString();
+                }
+                decoder.Clear();
+                is_open.store(opened, std::memory_order_release); },
+            Qt::BlockingQueuedConnection);
+        return opened;
+    }
+
+    void SerialWorker::Close()
+    {
+        QMetaObject::invokeMethod(
+            this, [this]()
+            {
+                if (serial_port && serial_port->isOpen())
+                {
+                    // 큐에 남은 프레임(TaskStop, ReleaseAllServos 등)을 보내고, 포트 버퍼가 비워질 때까지 기다립니다.
+                    FlushTx();
+                    if (serial_port->bytesToWrite() > 0 && !serial_port->waitForBytesWritten(CloseFlushTimeoutMs))
+                    {
+                        LogWarn << "Closing the port before all queued bytes were written: " << serial_port->errorString();
+                    }
+                    serial_port->close();
+                }
+                TxFrame frame;
+                while (tx_queue.Pop(frame))
+                {
+                }
+                tx_bytes_pending.store(0, std::memory_order_relaxed);
+                is_open.store(false, std::memory_order_release); },
+            Qt::BlockingQueuedConnection);
+    }
+
+    bool SerialWorker::Write(const char *data, std::size_t size)
+    {
+        TxFrame frame;
+        frame.size = static_cast<uint16_t>(std::min(size, sizeof(frame.data)));
+        std::memcpy(frame.data, data, frame.size);
+        if (!tx_queue.Push(frame))
+        {
+            return false;
+        }
+        tx_bytes_pending.fetch_add(frame.size, std::memory_order_relaxed);
+        // 이미 깨우기 요청이 걸려 있다면 같은 FlushTx()에서 함께 전송됩니다.
+        if (!tx_flush_pending.exchange(true, std::memory_order_acq_rel))
+        {
+            QMetaObject::invokeMethod(this, &SerialWorker::FlushTx, Qt::QueuedConnection);
+        }
+        return true;
+    }
+
+    void SerialWorker::HandleReadyRead()
+    {
+        char chunk[512];
+        bool pushed = false;
+        qint64 bytes_read = 0;
+        while ((bytes_read = serial_port->read(chunk, sizeof(chunk))) > 0)
+        {
+            std::size_t offset = 0;
+            while (offset < static_cast<std::size_t>(bytes_read))
+            {
+                offset += decoder.Feed(chunk + offset, static_cast<std::size_t>(bytes_read) - offset);
+
+                PacketView view;
+                while (decoder.Next(view))
+                {
+                    RxPacket packet;
+                    packet.command = view.command;
+                    packet.size = static_cast<unsigned char>(std::min(view.size, sizeof(packet.data)));
+                    std::memcpy(packet.data, view.data, packet.size);
+                    if (rx_queue.Push(packet))
+                    {
+                        pushed = true;
+                    }
+                    else
+                    {
+                        dropped_packets.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            }
+        }
+
+        const DecoderStats &stats = decoder.Stats();
+        decoded_packets.store(stats.packets, std::memory_order_relaxed);
+        resyncs.store(stats.resyncs, std::memory_order_relaxed);
+        discarded_bytes.store(stats.discarded_bytes, std::memory_order_relaxed);
+
+        // 소비 측이 아직 큐를 비우지 않았다면 다시 깨울 필요가 없습니다.
+        if (pushed && !rx_notify_pending.exchange(true, std::memory_order_acq_rel))
+        {
+            notify_rx();
+        }
+    }
+
+    DecoderStats SerialWorker::GetDecoderStats() const
+    {
+        DecoderStats stats;
+        stats.packets = decoded_packets.load(std::memory_order_relaxed);
+        stats.resyncs = resyncs.load(std::memory_order_relaxed);
+        stats.discarded_bytes = discarded_bytes.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void SerialWorker::FlushTx()
+    {
+        tx_flush_pending.store(false, std::memory_order_release);
+
+        // 큐에 쌓인 프레임을 한 번의 write()로 보냅니다.
+        tx_buffer.clear();
+        TxFrame frame;
+        while (tx_queue.Pop(frame))
+        {
+            tx_buffer.append(frame.data, frame.size);
+        }
+        if (tx_buffer.isEmpty() || !serial_port || !serial_port->isOpen())
+        {
+            return;
+        }
+        const qint64 bytes_written = serial_port->write(tx_buffer);
+        if (bytes_written != tx_buffer.size())
+        {
+            LogError << "Could not write data: " << serial_port->errorString();
+            // 포트에 넘기지 못한 바이트는 bytesWritten으로 확인될 일이 없습니다.
+            tx_bytes_pending.fetch_sub(tx_buffer.size() - std::max<qint64>(bytes_written, 0), std::memory_order_relaxed);
+            // QSerialPort가 에러를 설정하지 않은 부분 쓰기도 쓰기 에러로 알립니다.
+            if (serial_port->error() == QSerialPort::NoError)
+            {
+                emit errorOccurred(QSerialPort::WriteError);
+            }
+        }
+    }
+
+    void SerialWorker::HandleBytesWritten(qint64 bytes)
+    {
+        tx_bytes_pending.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+}
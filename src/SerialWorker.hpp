@@ -0,0 +1,115 @@
+#ifndef ROBOSIGNAL_SERIALWORKER_HPP
+#define ROBOSIGNAL_SERIALWORKER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include <QByteArray>
+#include <QObject>
+#include <QString>
+#include <QtSerialPort/qserialport.h>
+
+#include "PacketDecoder.hpp"
+#include "SpscQueue.hpp"
+
+namespace rc
+{
+
+    /// I/O 스레드에서 애플리케이션 스레드로 넘기는 디코딩된 패킷 (고정 크기, 할당 없음)
+    struct RxPacket
+    {
+        unsigned char command{0};
+        unsigned char size{0};
+        unsigned char data[255]{};
+
+        PacketView View() const { return PacketView{command, data, size}; }
+    };
+
+    /// 애플리케이션 스레드에서 I/O 스레드로 넘기는 송신 프레임
+    struct TxFrame
+    {
+        uint16_t size{0};
+        char data[PacketDecoder::MaxPacketSize]{};
+    };
+
+    /**
+     * @brief 전용 스레드에서 QSerialPort를 소유하고 수신/디코딩을 수행하는 워커.
+     *
+     * 수신 패킷은 SPSC 큐(rx)로, 송신 프레임은 SPSC 큐(tx)로 주고받습니다.
+     * 큐가 비어 있다가 채워질 때만 상대 스레드를 깨우므로, 패킷이 몰려도 알림은 한 번입니다.
+     * Open()/Close()를 제외한 public 함수는 애플리케이션 스레드에서만 호출합니다.
+     */
+    class SerialWorker : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        static constexpr std::size_t RxQueueSize = 256;
+        static constexpr std::size_t TxQueueSize = 64;
+        /// Close()가 송신 큐를 내보낸 뒤 전송 완료를 기다리는 최대 시간
+        static constexpr int CloseFlushTimeoutMs = 1000;
+
+        /// notify는 I/O 스레드에서 호출되며, 소비 측을 깨우는 역할만 해야 합니다.
+        explicit SerialWorker(std::function<void()> notify);
+        ~SerialWorker() override;
+
+        SerialWorker(const SerialWorker &) = delete;
+        SerialWorker &operator=(const SerialWorker &) = delete;
+
+        /// 워커 스레드에서 포트를 엽니다. 실패하면 error/error_string을 채우고 false를 반환합니다.
+        bool Open(const QString &port_name, int baud_rate,
+                  QSerialPort::SerialPortError &error, QString &error_string);
+        /// 송신 큐에 남은 프레임을 보낸 뒤 (최대 CloseFlushTimeoutMs 기다림) 포트를 닫습니다.
+        void Close();
+        bool IsOpen() const { return is_open.load(std::memory_order_acquire); }
+
+        /// 송신 큐에 프레임을 넣습니다. 큐가 가득 차 있으면 false를 반환합니다.
+        bool Write(const char *data, std::size_t size);
+
+        /// 아직 I/O 스레드가 꺼내지 않은 송신 프레임 수
+        std::size_t TxQueueDepth() const { return tx_queue.Size(); }
+        /// 큐에 넣었지만 bytesWritten으로 전송이 확인되지 않은 바이트 수
+        qint64 TxBytesPending() const { return tx_bytes_pending.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief 수신 큐에서 패킷을 하나 꺼냅니다.
+         * 큐를 비우기 전에 RearmNotify()를 호출해야 다음 알림을 놓치지 않습니다.
+         */
+        bool Pop(RxPacket &packet) { return rx_queue.Pop(packet); }
+        void RearmNotify() { rx_notify_pending.store(false, std::memory_order_release); }
+
+        /// 수신 큐가 가득 차서 버린 패킷 수
+        uint64_t DroppedPackets() const { return dropped_packets.load(std::memory_order_relaxed); }
+        /// I/O 스레드 디코더 통계 (수신 배치마다 갱신)
+        DecoderStats GetDecoderStats() const;
+
+    signals:
+        void errorOccurred(QSerialPort::SerialPortError error);
+
+    private slots:
+        void HandleReadyRead();
+        void FlushTx();
+        void HandleBytesWritten(qint64 bytes);
+
+    private:
+        std::function<void()> notify_rx;
+        QSerialPort *serial_port{nullptr};
+        PacketDecoder decoder{};
+        QByteArray tx_buffer{};
+
+        SpscQueue<RxPacket, RxQueueSize> rx_queue{};
+        SpscQueue<TxFrame, TxQueueSize> tx_queue{};
+        std::atomic<bool> rx_notify_pending{false};
+        std::atomic<bool> tx_flush_pending{false};
+        std::atomic<bool> is_open{false};
+        std::atomic<uint64_t> dropped_packets{0};
+        std::atomic<uint64_t> decoded_packets{0};
+        std::atomic<uint64_t> resyncs{0};
+        std::atomic<uint64_t> discarded_bytes{0};
+        std::atomic<qint64> tx_bytes_pending{0};
+    };
+
+}
+#endif
@@ -0,0 +1,68 @@
+#ifndef ROBOSIGNAL_SPSCQUEUE_HPP
+#define ROBOSIGNAL_SPSCQUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace rc
+{
+
+    /**
+     * @brief 단일 생산자/단일 소비자(SPSC) lock-free 큐.
+     * 고정 크기 배열만 사용하므로 Push/Pop 중에 힙 할당이 없습니다.
+     * Push()는 한 스레드에서만, Pop()은 다른 한 스레드에서만 호출해야 합니다.
+     */
+    template <typename T, std::size_t N>
+    class SpscQueue
+    {
+        static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscQueue size must be a power of two");
+
+    public:
+        /// 큐가 가득 차 있으면 false를 반환합니다.
+        bool Push(const T &item)
+        {
+            const std::size_t tail = write_index.load(std::memory_order_relaxed);
+            if (tail - read_index.load(std::memory_order_acquire) == N)
+            {
+                return false;
+            }
+            items[tail & (N - 1)] = item;
+            write_index.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// 큐가 비어 있으면 false를 반환합니다.
+        bool Pop(T &item)
+        {
+            const std::size_t head = read_index.load(std::memory_order_relaxed);
+            if (head == write_index.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+            item = items[head & (N - 1)];
+            read_index.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool Empty() const
+        {
+            return read_index.load(std::memory_order_acquire) == write_index.load(std::memory_order_acquire);
+        }
+
+        std::size_t Size() const
+        {
+            return write_index.load(std::memory_order_acquire) - read_index.load(std::memory_order_acquire);
+        }
+
+        static constexpr std::size_t Capacity() { return N; }
+
+    private:
+        // 생산자/소비자 인덱스가 같은 캐시 라인을 공유하지 않도록 분리합니다.
+        alignas(64) std::atomic<std::size_t> write_index{0};
+        alignas(64) std::atomic<std::size_t> read_index{0};
+        std::array<T, N> items{};
+    };
+
+}
+#endif
@@ -0,0 +1,112 @@
+#include "StatePredictor.hpp"
+
+#include <algorithm>
+
+#include "MotionEstimator.hpp"
+
+namespace rc
+{
+
+    namespace
+    {
+        bool Wrapped(unsigned wrap_mask, std::size_t i)
+        {
+            return (wrap_mask & (1u << i)) != 0;
+        }
+    }
+
+    Estimate<Angles> PredictState(const SampleRing<Angles> &history, const Sample<JointMotion> &motion,
+                                  const MotionCommand &command, std::chrono::steady_clock::time_point time,
+                                  std::chrono::steady_clock::duration max_extrapolation, unsigned wrap_mask)
+    {
+        Estimate<Angles> estimate;
+
+        // 최신 측정부터 거슬러 올라가며 time을 감싸는 두 측정(before <= time < after)을 찾습니다.
+        Sample<Angles> newest{};
+        Sample<Angles> oldest{};
+        Sample<Angles> before{};
+        Sample<Angles> after{};
+        bool has_before = false;
+        bool has_after = false;
+        history.ForEachNewest([&](const Sample<Angles> &sample)
+                              {
+            if (!newest.Valid())
+            {
+                newest = sample;
+            }
+            oldest = sample;
+            if (MeasuredAt(sample) <= time)
+            {
+                before = sample;
+                has_before = true;
+                return false;
+            }
+            after = sample;
+            has_after = true;
+            return true; });
+        if (!newest.Valid())
+        {
+            return estimate;
+        }
+
+        if (!has_before)
+        {
+            // 이력보다 이른 시각: 남아 있는 가장 오래된 측정
+            estimate.value = oldest.value;
+            estimate.kind = EstimateKind::Held;
+            estimate.horizon = MeasuredAt(oldest) - time;
+            return estimate;
+        }
+
+        if (has_after)
+        {
+            const auto t0 = MeasuredAt(before);
+            const auto t1 = MeasuredAt(after);
+            const double span = std::chrono::duration<double>(t1 - t0).count();
+            const double w = span > 0.0 ? std::chrono::duration<double>(time - t0).count() / span : 1.0;
+            for (std::size_t i = 0; i < Joints; ++i)
+            {
+                const double delta = after.value[i] - before.value[i];
+                const double value = before.value[i] + w * (Wrapped(wrap_mask, i) ? WrapDegrees(delta) : delta);
+                estimate.value[i] = Wrapped(wrap_mask, i) ? WrapDegrees(value) : value;
+            }
+            estimate.kind = EstimateKind::Interpolated;
+            estimate.horizon = std::min(time - t0, t1 - time);
+            estimate.uncertain = estimate.horizon > max_extrapolation;
+            return estimate;
+        }
+
+        // 마지막 측정 뒤: 추정 운동으로 외삽
+        const auto newest_at = MeasuredAt(newest);
+        estimate.horizon = time - newest_at;
+        estimate.uncertain = estimate.horizon > max_extrapolation ||
+                             (command.mask != 0 && command.sent_at > newest_at); // 새 명령의 움직임은 아직 측정되지 않았음
+        if (!motion.Valid())
+        {
+            estimate.value = newest.value;
+            estimate.kind = EstimateKind::Held;
+            return estimate;
+        }
+        const auto elapsed = std::clamp(time - MeasuredAt(motion), std::chrono::steady_clock::duration::zero(), max_extrapolation);
+        const double dt = std::chrono::duration<double>(elapsed).count();
+        for (std::size_t i = 0; i < Joints; ++i)
+        {
+            const double position = motion.value.position[i];
+            double step = motion.value.velocity[i] * dt;
+            if ((command.mask & (1u << i)) != 0)
+            {
+                // 목표를 향해 움직이는 중이면 목표에서 멈춥니다.
+                const double delta = command.target[i] - position;
+                const double remaining = Wrapped(wrap_mask, i) ? WrapDegrees(delta) : delta;
+                if ((remaining > 0.0 && step > remaining) || (remaining < 0.0 && step < remaining))
+                {
+                    step = remaining;
+                }
+            }
+            estimate.value[i] = Wrapped(wrap_mask, i) ? WrapDegrees(position + step) : position + step;
+        }
+        estimate.kind = EstimateKind::Extrapolated;
+        return estimate;
+    }
+
+}
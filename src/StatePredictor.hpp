@@ -0,0 +1,36 @@
+#ifndef ROBOSIGNAL_STATEPREDICTOR_HPP
+#define ROBOSIGNAL_STATEPREDICTOR_HPP
+
+#include <chrono>
+
+#include "MyCobot.hpp"
+#include "TelemetryHistory.hpp"
+
+namespace rc
+{
+
+    /// 샘플의 측정 시각으로 보는 값: 요청과 응답의 중간
+    template <typename T>
+    std::chrono::steady_clock::time_point MeasuredAt(const Sample<T> &sample)
+    {
+        return sample.sent_at + (sample.received_at - sample.sent_at) / 2;
+    }
+
+    /**
+     * @brief 측정 이력, 추정 운동, 마지막 명령으로 time 시각의 값을 추정합니다.
+     *
+     * - time을 감싸는 두 측정이 이력에 있으면 선형 보간합니다. (Interpolated)
+     * - 마지막 측정보다 늦으면 motion의 위치에서 추정 속도로 외삽합니다. (Extrapolated)
+     *   외삽 거리는 max_extrapolation까지만이고, command에 목표가 있는 요소는 목표를 넘지 않습니다.
+     *   motion이 없으면 마지막 측정값을 그대로 씁니다. (Held)
+     * - 이력의 가장 오래된 측정보다 이르면 그 측정값을 그대로 씁니다. (Held, uncertain)
+     *
+     * wrap_mask의 요소는 ±180도에서 넘어가는 각도로 보고 최단 방향으로 보간합니다.
+     * history는 다른 스레드가 쓰는 중이어도 읽을 수 있습니다.
+     */
+    Estimate<Angles> PredictState(const SampleRing<Angles> &history, const Sample<JointMotion> &motion,
+                                  const MotionCommand &command, std::chrono::steady_clock::time_point time,
+                                  std::chrono::steady_clock::duration max_extrapolation, unsigned wrap_mask);
+
+}
+#endif
@@ -0,0 +1,228 @@
+#include "TelemetryFile.hpp"
+
+#include <algorithm>
+#include <array>
+
+#ifdef OS_UNIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace rc
+{
+
+    namespace
+    {
+        struct ChannelFormat
+        {
+            const char *name;
+            std::size_t value_size;
+        };
+
+        constexpr std::array<ChannelFormat, TelemetryChannelCount> ChannelFormats{{
+            {"angles", sizeof(Angles)},
+            {"coords", sizeof(Coords)},
+            {"encoders", sizeof(Angles)},
+            {"speeds", sizeof(IntAngles)},
+            {"voltages", sizeof(Voltages)},
+            {"is_moving", sizeof(bool)},
+            {"load_j1", sizeof(int)},
+            {"load_j2", sizeof(int)},
+            {"load_j3", sizeof(int)},
+            {"load_j4", sizeof(int)},
+            {"load_j5", sizeof(int)},
+            {"load_j6", sizeof(int)},
+        }};
+
+        std::size_t ChannelIndex(TelemetryChannel channel)
+        {
+            return std::min(static_cast<std::size_t>(channel), TelemetryChannelCount - 1);
+        }
+    }
+
+    std::size_t TelemetryValueSize(TelemetryChannel channel)
+    {
+        return ChannelFormats[ChannelIndex(channel)].value_size;
+    }
+
+    std::size_t TelemetryRecordSize(TelemetryChannel channel)
+    {
+        return (sizeof(TelemetryRecordHeader) + TelemetryValueSize(channel) + 7) & ~std::size_t{7};
+    }
+
+    const char *TelemetryChannelName(TelemetryChannel channel)
+    {
+        return ChannelFormats[ChannelIndex(channel)].name;
+    }
+
+    TelemetryReader::~TelemetryReader()
+    {
+        Close();
+    }
+
+    bool TelemetryReader::Fail(const std::string &message)
+    {
+        Close();
+        error_string = message;
+        return false;
+    }
+
+    bool TelemetryReader::Open(const std::string &path)
+    {
+        Close();
+        error_string.clear();
+#ifdef OS_UNIX
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            return Fail("Could not open " + path + ": " + std::strerror(errno));
+        }
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(TelemetryHeaderSize))
+        {
+            ::close(fd);
+            return Fail("Not a telemetry file (too small): " + path);
+        }
+        void *mapped = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd); // 매핑은 파일 디스크립터를 닫아도 유지됩니다.
+        if (mapped == MAP_FAILED)
+        {
+            return Fail("Could not map " + path + ": " + std::strerror(errno));
+        }
+        data = static_cast<const unsigned char *>(mapped);
+        size = static_cast<std::size_t>(st.st_size);
+#else
+        return Fail("Memory-mapped telemetry files are not supported on this platform: " + path);
+#endif
+
+        std::memcpy(&header, data, sizeof(header));
+        if (header.magic != TelemetryFileMagic || header.byte_order != TelemetryByteOrderMark)
+        {
+            return Fail("Not a telemetry file (bad magic or byte order): " + path);
+        }
+        if (header.version != TelemetryFileVersion || header.header_size != TelemetryHeaderSize ||
+            header.block_size != TelemetryBlockSize || header.channel_count != TelemetryChannelCount)
+        {
+            return Fail("Unsupported telemetry file version or layout: " + path);
+        }
+        for (std::size_t i = 0; i < TelemetryChannelCount; ++i)
+        {
+            if (header.record_size[i] != TelemetryRecordSize(static_cast<TelemetryChannel>(i)))
+            {
+                return Fail("Telemetry record layout mismatch: " + path);
+            }
+        }
+
+        // 블록 헤더만 훑어 채널별 블록 목록(시간 색인)을 만듭니다. 아직 쓰지 않은 블록은 magic이 0입니다.
+        for (std::size_t offset = TelemetryHeaderSize; offset + TelemetryBlockSize <= size; offset += TelemetryBlockSize)
+        {
+            TelemetryBlockHeader block_header;
+            std::memcpy(&block_header, data + offset, sizeof(block_header));
+            if (block_header.magic != TelemetryBlockMagic || block_header.channel >= TelemetryChannelCount ||
+                block_header.count == 0)
+            {
+                continue;
+            }
+            const std::size_t record_size = header.record_size[block_header.channel];
+            const std::size_t capacity = (TelemetryBlockSize - sizeof(TelemetryBlockHeader)) / record_size;
+            std::vector<Block> &channel_blocks = blocks[block_header.channel];
+            Block block;
+            block.records = data + offset + sizeof(TelemetryBlockHeader);
+            block.first_index = channel_blocks.empty() ? 0 : channel_blocks.back().first_index + channel_blocks.back().count;
+            block.count = std::min<std::size_t>(block_header.count, capacity);
+            block.last_ns = block_header.last_ns;
+            channel_blocks.push_back(block);
+        }
+        return true;
+    }
+
+    void TelemetryReader::Close()
+    {
+#ifdef OS_UNIX
+        if (data)
+        {
+            ::munmap(const_cast<unsigned char *>(data), size);
+        }
+#endif
+        data = nullptr;
+        size = 0;
+        header = TelemetryFileHeader{};
+        for (std::vector<Block> &channel_blocks : blocks)
+        {
+            channel_blocks.clear();
+        }
+    }
+
+    std::chrono::steady_clock::time_point TelemetryReader::StartTime() const
+    {
+        return FromTelemetryNs(header.start_steady_ns);
+    }
+
+    std::chrono::system_clock::time_point TelemetryReader::ToSystemTime(std::chrono::steady_clock::time_point time) const
+    {
+        const int64_t ns = header.start_system_ns + (ToTelemetryNs(time) - header.start_steady_ns);
+        return std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(ns)));
+    }
+
+    std::size_t TelemetryReader::Count(TelemetryChannel channel) const
+    {
+        const std::vector<Block> &channel_blocks = blocks[ChannelIndex(channel)];
+        return channel_blocks.empty() ? 0 : channel_blocks.back().first_index + channel_blocks.back().count;
+    }
+
+    const unsigned char *TelemetryReader::Record(TelemetryChannel channel, std::size_t index) const
+    {
+        const std::vector<Block> &channel_blocks = blocks[ChannelIndex(channel)];
+        auto it = std::upper_bound(channel_blocks.begin(), channel_blocks.end(), index,
+                                   [](std::size_t value, const Block &block)
+                                   { return value < block.first_index; });
+        if (it == channel_blocks.begin())
+        {
+            return nullptr;
+        }
+        --it;
+        if (index - it->first_index >= it->count)
+        {
+            return nullptr;
+        }
+        return it->records + (index - it->first_index) * header.record_size[ChannelIndex(channel)];
+    }
+
+    std::size_t TelemetryReader::LowerBound(TelemetryChannel channel, std::chrono::steady_clock::time_point time) const
+    {
+        const std::vector<Block> &channel_blocks = blocks[ChannelIndex(channel)];
+        const int64_t ns = ToTelemetryNs(time);
+        // 1. last_ns가 ns 이상인 첫 블록
+        auto it = std::lower_bound(channel_blocks.begin(), channel_blocks.end(), ns,
+                                   [](const Block &block, int64_t value)
+                                   { return block.last_ns < value; });
+        if (it == channel_blocks.end())
+        {
+            return Count(channel);
+        }
+        // 2. 블록 안에서 received_ns가 ns 이상인 첫 레코드
+        const std::size_t record_size = header.record_size[ChannelIndex(channel)];
+        std::size_t low = 0;
+        std::size_t high = it->count;
+        while (low < high)
+        {
+            const std::size_t mid = low + (high - low) / 2;
+            int64_t received_ns = 0;
+            std::memcpy(&received_ns, it->records + mid * record_size, sizeof(received_ns));
+            if (received_ns < ns)
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+        return it->first_index + low;
+    }
+
+}
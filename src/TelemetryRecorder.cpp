@@ -0,0 +1,230 @@
+#include "TelemetryRecorder.hpp"
+
+#include <chrono>
+
+#ifdef OS_UNIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace rc
+{
+
+    namespace
+    {
+        constexpr std::chrono::milliseconds IdleWait{5}; // 큐가 비었을 때 기록 스레드가 쉬는 시간
+
+        constexpr std::size_t FileSizeFor(std::size_t blocks)
+        {
+            return TelemetryHeaderSize + blocks * TelemetryBlockSize;
+        }
+    }
+
+    TelemetryRecorder::~TelemetryRecorder()
+    {
+        Stop();
+    }
+
+    bool TelemetryRecorder::Start(const std::string &path, std::string &error)
+    {
+        Stop();
+#ifdef OS_UNIX
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            error = "Could not create " + path + ": " + std::strerror(errno);
+            return false;
+        }
+        mapped_blocks = 0;
+        used_blocks = 0;
+        current_block.fill(0);
+        if (!Grow())
+        {
+            error = "Could not allocate " + path + ": " + std::strerror(errno);
+            ::close(fd);
+            fd = -1;
+            return false;
+        }
+
+        TelemetryFileHeader header;
+        header.start_steady_ns = ToTelemetryNs(std::chrono::steady_clock::now());
+        header.start_system_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::system_clock::now().time_since_epoch())
+                                     .count();
+        for (std::size_t i = 0; i < TelemetryChannelCount; ++i)
+        {
+            header.record_size[i] = static_cast<uint16_t>(TelemetryRecordSize(static_cast<TelemetryChannel>(i)));
+        }
+        std::memcpy(map, &header, sizeof(header));
+
+        written.store(0, std::memory_order_relaxed);
+        dropped.store(0, std::memory_order_relaxed);
+        failed.store(false, std::memory_order_relaxed);
+        stop_requested.store(false, std::memory_order_relaxed);
+        worker = std::thread(&TelemetryRecorder::Run, this);
+        recording.store(true, std::memory_order_release);
+        return true;
+#else
+        error = "Memory-mapped telemetry recording is not supported on this platform: " + path;
+        return false;
+#endif
+    }
+
+    void TelemetryRecorder::Stop()
+    {
+        // 생산자(Record)와 같은 스레드에서 호출되므로, 이 뒤로는 큐에 새 샘플이 들어오지 않습니다.
+        recording.store(false, std::memory_order_release);
+        if (worker.joinable())
+        {
+            stop_requested.store(true, std::memory_order_release);
+            worker.join();
+        }
+    }
+
+    void TelemetryRecorder::Run()
+    {
+        Item item;
+        for (;;)
+        {
+            bool any = false;
+            while (queue.Pop(item))
+            {
+                Write(item);
+                any = true;
+            }
+            if (stop_requested.load(std::memory_order_acquire))
+            {
+                while (queue.Pop(item))
+                {
+                    Write(item);
+                }
+                break;
+            }
+            if (!any)
+            {
+                std::this_thread::sleep_for(IdleWait);
+            }
+        }
+        Finish();
+    }
+
+    void TelemetryRecorder::Write(const Item &item)
+    {
+        if (failed.load(std::memory_order_relaxed))
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        const auto channel = static_cast<std::size_t>(item.channel);
+        const std::size_t record_size = TelemetryRecordSize(item.channel);
+
+        TelemetryBlockHeader block;
+        std::size_t offset = current_block[channel];
+        if (offset != 0)
+        {
+            std::memcpy(&block, map + offset, sizeof(block));
+        }
+        if (offset == 0 || block.count == block.capacity)
+        {
+            offset = AllocateBlock(item.channel);
+            if (offset == 0)
+            {
+                failed.store(true, std::memory_order_release);
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            std::memcpy(&block, map + offset, sizeof(block));
+        }
+
+        // 레코드를 다 쓴 뒤에 count를 늘립니다.
+        unsigned char *record = map + offset + sizeof(TelemetryBlockHeader) + block.count * record_size;
+        std::memcpy(record, &item.header, sizeof(item.header));
+        std::memcpy(record + sizeof(item.header), item.value.data(), TelemetryValueSize(item.channel));
+        if (block.count == 0)
+        {
+            block.first_ns = item.header.received_ns;
+        }
+        block.last_ns = item.header.received_ns;
+        ++block.count;
+        std::memcpy(map + offset, &block, sizeof(block));
+        written.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::size_t TelemetryRecorder::AllocateBlock(TelemetryChannel channel)
+    {
+        if (used_blocks == mapped_blocks && !Grow())
+        {
+            return 0;
+        }
+        const std::size_t offset = FileSizeFor(used_blocks++);
+
+        TelemetryBlockHeader block;
+        block.magic = TelemetryBlockMagic;
+        block.channel = static_cast<uint16_t>(channel);
+        block.record_size = static_cast<uint16_t>(TelemetryRecordSize(channel));
+        block.capacity = static_cast<uint32_t>((TelemetryBlockSize - sizeof(TelemetryBlockHeader)) / block.record_size);
+        std::memcpy(map + offset, &block, sizeof(block));
+        current_block[static_cast<std::size_t>(channel)] = offset;
+        return offset;
+    }
+
+    bool TelemetryRecorder::Grow()
+    {
+#ifdef OS_UNIX
+        const std::size_t old_size = FileSizeFor(mapped_blocks);
+        const std::size_t new_size = FileSizeFor(mapped_blocks + GrowBlocks);
+        // 늘어난 부분은 0으로 채워지므로, 아직 쓰지 않은 블록은 magic이 0입니다.
+        if (::ftruncate(fd, static_cast<off_t>(new_size)) != 0)
+        {
+            return false;
+        }
+        if (map)
+        {
+            ::munmap(map, old_size);
+            map = nullptr;
+        }
+        void *mapped = ::mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED)
+        {
+            return false;
+        }
+        map = static_cast<unsigned char *>(mapped);
+        mapped_blocks += GrowBlocks;
+        file_size.store(new_size, std::memory_order_relaxed);
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void TelemetryRecorder::Finish()
+    {
+#ifdef OS_UNIX
+        if (map)
+        {
+            TelemetryFileHeader header;
+            std::memcpy(&header, map, sizeof(header));
+            header.block_count = used_blocks;
+            std::memcpy(map, &header, sizeof(header));
+            ::msync(map, FileSizeFor(mapped_blocks), MS_ASYNC);
+            ::munmap(map, FileSizeFor(mapped_blocks));
+            map = nullptr;
+        }
+        if (fd >= 0)
+        {
+            // 미리 늘려 둔 빈 블록은 잘라 냅니다.
+            if (::ftruncate(fd, static_cast<off_t>(FileSizeFor(used_blocks))) == 0)
+            {
+                file_size.store(FileSizeFor(used_blocks), std::memory_order_relaxed);
+            }
+            ::close(fd);
+            fd = -1;
+        }
+#endif
+        mapped_blocks = 0;
+        used_blocks = 0;
+    }
+
+}
@@ -0,0 +1,103 @@
+#ifndef ROBOSIGNAL_TELEMETRYRECORDER_HPP
+#define ROBOSIGNAL_TELEMETRYRECORDER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "SpscQueue.hpp"
+#include "TelemetryFile.hpp"
+
+namespace rc
+{
+
+    /**
+     * @brief 디코딩된 샘플을 메모리 매핑된 열(column) 형식 파일에 이어 씁니다. (TelemetryFile.hpp)
+     *
+     * Record()는 디코딩 경로(한 스레드)에서 호출하며 SPSC 큐에 넣기만 하므로 I/O를 기다리지 않습니다.
+     * 큐가 가득 차면 샘플을 버리고 Dropped()에 셉니다. 기록 스레드가 큐를 비워 매핑된 파일에 쓰고,
+     * 블록이 모자라면 GrowBlocks개씩 파일을 늘립니다. Stop()은 남은 샘플을 모두 쓰고 파일을 쓴 만큼 줄입니다.
+     */
+    class TelemetryRecorder
+    {
+    public:
+        static constexpr std::size_t QueueSize = 4096;
+        static constexpr std::size_t GrowBlocks = 64; // 4 MiB
+        static constexpr std::size_t MaxValueSize = 48;
+
+        TelemetryRecorder() = default;
+        ~TelemetryRecorder();
+
+        TelemetryRecorder(const TelemetryRecorder &) = delete;
+        TelemetryRecorder &operator=(const TelemetryRecorder &) = delete;
+
+        /// 파일을 새로 만들고 기록 스레드를 시작합니다. 실패하면 error에 이유를 남기고 false를 반환합니다.
+        bool Start(const std::string &path, std::string &error);
+        void Stop();
+        bool IsRecording() const { return recording.load(std::memory_order_acquire); }
+
+        template <typename T>
+        void Record(TelemetryChannel channel, const Sample<T> &sample)
+        {
+            static_assert(sizeof(T) <= MaxValueSize, "telemetry value too large");
+            if (!recording.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+            Item item;
+            item.channel = channel;
+            item.header.received_ns = ToTelemetryNs(sample.received_at);
+            item.header.sent_ns = ToTelemetryNs(sample.sent_at);
+            item.header.sequence = sample.sequence;
+            std::memcpy(item.value.data(), &sample.value, sizeof(T));
+            if (!queue.Push(item))
+            {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        uint64_t Written() const { return written.load(std::memory_order_relaxed); }
+        uint64_t Dropped() const { return dropped.load(std::memory_order_relaxed); }
+        /// 지금까지 할당한 파일 크기 (바이트)
+        uint64_t FileSize() const { return file_size.load(std::memory_order_relaxed); }
+        /// 쓰기 실패(디스크 부족 등)로 기록을 멈췄으면 true
+        bool Failed() const { return failed.load(std::memory_order_acquire); }
+
+    private:
+        struct Item
+        {
+            TelemetryRecordHeader header{};
+            TelemetryChannel channel{TelemetryChannel::CH_Angles};
+            std::array<unsigned char, MaxValueSize> value{};
+        };
+
+        void Run();
+        void Write(const Item &item);
+        std::size_t AllocateBlock(TelemetryChannel channel);
+        bool Grow();
+        void Finish();
+
+        SpscQueue<Item, QueueSize> queue{};
+        std::thread worker{};
+        std::atomic<bool> recording{false};
+        std::atomic<bool> stop_requested{false};
+        std::atomic<bool> failed{false};
+        std::atomic<uint64_t> written{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<uint64_t> file_size{0};
+
+        // --- 기록 스레드만 사용 ---
+        int fd{-1};
+        unsigned char *map{nullptr};
+        std::size_t mapped_blocks{0}; // 파일에 자리가 잡힌 블록 수
+        std::size_t used_blocks{0};   // 채널에 할당한 블록 수
+        // 채널별로 쓰는 중인 블록의 파일 오프셋 (0이면 없음). 파일을 늘리면 다시 매핑하므로 포인터 대신 오프셋
+        std::array<std::size_t, TelemetryChannelCount> current_block{};
+    };
+
+}
+#endif
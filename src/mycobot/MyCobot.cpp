@@ -286,6 +286,124 @@ namespace mycobot
         return rc::MyCobot::Instance().PeekIsMoving();
     }
 
+    namespace
+    {
+        template <typename T>
+        Sample<T> ToSample(const rc::Sample<T> &sample)
+        {
+            Sample<T> result;
+            result.value = sample.value;
+            result.sent_at = sample.sent_at;
+            result.received_at = sample.received_at;
+            result.sequence = sample.sequence;
+            return result;
+        }
+
+        Sample<JointMotion> ToSample(const rc::Sample<rc::JointMotion> &sample)
+        {
+            Sample<JointMotion> result;
+            result.value.position = sample.value.position;
+            result.value.velocity = sample.value.velocity;
+            result.value.acceleration = sample.value.acceleration;
+            result.sent_at = sample.sent_at;
+            result.received_at = sample.received_at;
+            result.sequence = sample.sequence;
+            return result;
+        }
+
+        EstimateKind ToEstimateKind(rc::EstimateKind kind)
+        {
+            switch (kind)
+            {
+            case rc::EstimateKind::Interpolated:
+                return EstimateKind::Interpolated;
+            case rc::EstimateKind::Extrapolated:
+                return EstimateKind::Extrapolated;
+            case rc::EstimateKind::Held:
+                return EstimateKind::Held;
+            case rc::EstimateKind::NoData:
+            default:
+                return EstimateKind::NoData;
+            }
+        }
+
+        template <typename T>
+        Estimate<T> ToEstimate(const rc::Estimate<T> &estimate)
+        {
+            Estimate<T> result;
+            result.value = estimate.value;
+            result.kind = ToEstimateKind(estimate.kind);
+            result.uncertain = estimate.uncertain;
+            result.horizon = estimate.horizon;
+            return result;
+        }
+    }
+
+    Sample<Angles> MyCobot::PeekAnglesSample() const
+    {
+        return ToSample(rc::MyCobot::Instance().PeekAnglesSample());
+    }
+
+    Sample<Coords> MyCobot::PeekCoordsSample() const
+    {
+        return ToSample(rc::MyCobot::Instance().PeekCoordsSample());
+    }
+
+    Sample<Angles> MyCobot::PeekEncodersSample() const
+    {
+        return ToSample(rc::MyCobot::Instance().PeekEncodersSample());
+    }
+
+    Sample<IntAngles> MyCobot::PeekSpeedsSample() const
+    {
+        return ToSample(rc::MyCobot::Instance().PeekSpeedsSample());
+    }
+
+    Sample<Voltages> MyCobot::PeekVoltagesSample() const
+    {
+        return ToSample(rc::MyCobot::Instance().PeekVoltagesSample());
+    }
+
+    Sample<int> MyCobot::PeekJointLoadSample(Joint joint) const
+    {
+        return ToSample(rc::MyCobot::Instance().PeekJointLoadSample(static_cast<rc::Joint>(joint)));
+    }
+
+    Sample<bool> MyCobot::PeekIsMovingSample() const
+    {
+        return ToSample(rc::MyCobot::Instance().PeekIsMovingSample());
+    }
+
+    Sample<JointMotion> MyCobot::PeekJointMotion() const
+    {
+        return ToSample(rc::MyCobot::Instance().PeekJointMotion());
+    }
+
+    Sample<JointMotion> MyCobot::PeekEncoderMotion() const
+    {
+        return ToSample(rc::MyCobot::Instance().PeekEncoderMotion());
+    }
+
+    void MyCobot::SetMotionEstimator(int time_constant_ms, int max_gap_ms)
+    {
+        rc::MyCobot::Instance().SetMotionEstimator(time_constant_ms, max_gap_ms);
+    }
+
+    Estimate<Angles> MyCobot::PeekAnglesAt(std::chrono::steady_clock::time_point time) const
+    {
+        return ToEstimate(rc::MyCobot::Instance().PeekAnglesAt(time));
+    }
+
+    Estimate<Coords> MyCobot::PeekCoordsAt(std::chrono::steady_clock::time_point time) const
+    {
+        return ToEstimate(rc::MyCobot::Instance().PeekCoordsAt(time));
+    }
+
+    void MyCobot::SetPredictionHorizon(int max_extrapolation_ms)
+    {
+        rc::MyCobot::Instance().SetPredictionHorizon(max_extrapolation_ms);
+    }
+
     // ==========================================================
     // 그리퍼 제어
     // ==========================================================
@@ -302,4 +420,43 @@ namespace mycobot
         }
     }
 
+    // ==========================================================
+    // 통신 진단
+    // ==========================================================
+
+    namespace
+    {
+        LatencyStats ToLatencyStats(const rc::LatencyStats &stats)
+        {
+            LatencyStats result;
+            result.command = stats.command;
+            result.count = stats.count;
+            result.p50_us = stats.p50_us;
+            result.p99_us = stats.p99_us;
+            result.max_us = stats.max_us;
+            result.mean_us = stats.mean_us;
+            return result;
+        }
+    }
+
+    LatencyStats MyCobot::GetLatencyStats(int command) const
+    {
+        return ToLatencyStats(rc::MyCobot::Instance().GetLatencyStats(static_cast<unsigned char>(command)));
+    }
+
+    std::vector<LatencyStats> MyCobot::GetAllLatencyStats() const
+    {
+        std::vector<LatencyStats> result;
+        for (const rc::LatencyStats &stats : rc::MyCobot::Instance().GetAllLatencyStats())
+        {
+            result.push_back(ToLatencyStats(stats));
+        }
+        return result;
+    }
+
+    void MyCobot::ResetLatencyStats()
+    {
+        rc::MyCobot::Instance().ResetLatencyStats();
+    }
+
 } // namespace mycobot
@@ -0,0 +1,467 @@
+/**
+ * @file MyCobotBench.cpp
+ * @brief 파싱/디코딩/인코딩 핫패스 마이크로벤치마크
+ *
+ * 사용법:
+ * ./mycobot_bench [--filter SUBSTR] [--min-time-ms N] [--out FILE]
+ *
+ * 결과는 JSON으로 출력됩니다 (기본: 표준 출력). 각 항목은 처리 단위(패킷, 프레임, 호출)당
+ * 평균 시간(ns_per_item)과 힙 할당 수(allocs_per_item)를 담습니다.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <QByteArray>
+
+#include "Common.hpp"
+#include "Firmata.hpp"
+#include "FrameEncoder.hpp"
+#include "PacketDecoder.hpp"
+
+// ======================================================================
+// 할당 카운터: 전역 operator new를 대체해 측정 구간의 힙 할당 수를 셉니다.
+// ======================================================================
+namespace
+{
+  std::atomic<uint64_t> g_allocations{0};
+}
+
+void *operator new(std::size_t size)
+{
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(size == 0 ? 1 : size))
+  {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void *p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  /// 컴파일러가 결과를 버리지 못하게 합니다.
+  template <typename T>
+  void DoNotOptimize(const T &value)
+  {
+    asm volatile("" : : "r,m"(value) : "memory");
+  }
+
+  struct Result
+  {
+    std::string name{};
+    uint64_t iterations{0};
+    uint64_t items{0};
+    double ns_per_item{0.0};
+    double allocs_per_item{0.0};
+  };
+
+  struct Options
+  {
+    std::string filter{};
+    std::chrono::milliseconds min_time{std::chrono::milliseconds{200}};
+    std::string out{};
+  };
+
+  /**
+   * @brief body를 min_time 이상 반복 실행하고 항목당 시간/할당을 측정합니다.
+   * body는 한 번 호출에 items_per_call개의 항목(패킷, 프레임 등)을 처리해야 합니다.
+   */
+  Result Measure(const Options &options, const std::string &name, uint64_t items_per_call,
+                 const std::function<void()> &body)
+  {
+    // 워밍업
+    for (int i = 0; i < 10; ++i)
+    {
+      body();
+    }
+
+    uint64_t iterations = 1;
+    while (true)
+    {
+      const uint64_t allocations_before = g_allocations.load(std::memory_order_relaxed);
+      const Clock::time_point start = Clock::now();
+      for (uint64_t i = 0; i < iterations; ++i)
+      {
+        body();
+      }
+      const Clock::duration elapsed = Clock::now() - start;
+      const uint64_t allocations = g_allocations.load(std::memory_order_relaxed) - allocations_before;
+
+      if (elapsed >= options.min_time || iterations >= (uint64_t{1} << 40))
+      {
+        Result result;
+        result.name = name;
+        result.iterations = iterations;
+        result.items = iterations * items_per_call;
+        result.ns_per_item = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+                             static_cast<double>(result.items);
+        result.allocs_per_item = static_cast<double>(allocations) / static_cast<double>(result.items);
+        return result;
+      }
+      iterations *= 2;
+    }
+  }
+
+  /// --filter에 맞는 벤치마크만 실행해 results에 추가합니다.
+  void Run(const Options &options, std::vector<Result> &results, const std::string &name,
+           uint64_t items_per_call, const std::function<void()> &body)
+  {
+    if (!options.filter.empty() && name.find(options.filter) == std::string::npos)
+    {
+      return;
+    }
+    results.push_back(Measure(options, name, items_per_call, body));
+  }
+
+  // ======================================================================
+  // 테스트 스트림 생성
+  // ======================================================================
+  constexpr int StreamPackets = 256;
+
+  rc::Angles SampleAngles(std::mt19937 &rng)
+  {
+    std::uniform_real_distribution<double> dist(-165.0, 165.0);
+    rc::Angles angles{};
+    for (double &angle : angles)
+    {
+      angle = dist(rng);
+    }
+    return angles;
+  }
+
+  rc::Coords SampleCoords(std::mt19937 &rng)
+  {
+    std::uniform_real_distribution<double> position(-280.0, 280.0);
+    std::uniform_real_distribution<double> rotation(-180.0, 180.0);
+    return rc::Coords{position(rng), position(rng), position(rng), rotation(rng), rotation(rng), rotation(rng)};
+  }
+
+  /// 로봇 응답 형태의 프레임 스트림 (각도/좌표/속도/불리언 응답 혼합)
+  QByteArray CleanStream(std::mt19937 &rng)
+  {
+    using namespace rc::field;
+    using AnglesReply = rc::FrameSpec<rc::Command::GetAngles, I16Array<100, rc::Joints>>;
+    using CoordsReply = rc::FrameSpec<rc::Command::GetCoords, CoordsI16>;
+    using SpeedsReply = rc::FrameSpec<rc::Command::GET_SERVO_SPEEDS, I16Array<1, rc::Joints>>;
+    using RunningReply = rc::FrameSpec<rc::Command::CheckRunning, U8>;
+
+    QByteArray stream;
+    for (int i = 0; i < StreamPackets; ++i)
+    {
+      switch (i % 4)
+      {
+      case 0:
+      {
+        const auto frame = AnglesReply::Encode(SampleAngles(rng));
+        stream.append(frame.data(), static_cast<int>(frame.size()));
+        break;
+      }
+      case 1:
+      {
+        const auto frame = CoordsReply::Encode(SampleCoords(rng));
+        stream.append(frame.data(), static_cast<int>(frame.size()));
+        break;
+      }
+      case 2:
+      {
+        const auto frame = SpeedsReply::Encode(SampleAngles(rng));
+        stream.append(frame.data(), static_cast<int>(frame.size()));
+        break;
+      }
+      default:
+      {
+        const auto frame = RunningReply::Encode(i & 1);
+        stream.append(frame.data(), static_cast<int>(frame.size()));
+        break;
+      }
+      }
+    }
+    return stream;
+  }
+
+  /// 프레임 사이에 잡음 바이트와 깨진 프레임(잘못된 푸터)을 섞은 스트림
+  QByteArray NoisyStream(const QByteArray &clean, std::mt19937 &rng)
+  {
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::uniform_int_distribution<int> gap(0, 6);
+    QByteArray noisy;
+    for (int i = 0; i < clean.size(); ++i)
+    {
+      // 프레임 헤더 앞마다 잡음을 넣습니다.
+      if (i + 1 < clean.size() && clean[i] == '\xFE' && clean[i + 1] == '\xFE')
+      {
+        const int count = gap(rng);
+        for (int k = 0; k < count; ++k)
+        {
+          noisy.append(static_cast<char>(byte(rng)));
+        }
+        if (count == 6)
+        {
+          // 깨진 프레임: 헤더 + LEN만 있고 본문이 잘린 경우
+          noisy.append("\xFE\xFE\x0E\x20\x01", 5);
+        }
+      }
+      noisy.append(clean[i]);
+    }
+    return noisy;
+  }
+
+  /// 스트림을 1~7바이트 조각으로 나눕니다 (USB 수신 단위가 작을 때).
+  std::vector<QByteArray> Fragment(const QByteArray &stream, std::mt19937 &rng)
+  {
+    std::uniform_int_distribution<int> length(1, 7);
+    std::vector<QByteArray> fragments;
+    for (int offset = 0; offset < stream.size();)
+    {
+      const int size = std::min(length(rng), stream.size() - offset);
+      fragments.push_back(stream.mid(offset, size));
+      offset += size;
+    }
+    return fragments;
+  }
+
+  std::size_t CountPackets(const QByteArray &stream)
+  {
+    rc::PacketDecoder decoder(static_cast<std::size_t>(stream.size()));
+    decoder.Feed(stream.constData(), static_cast<std::size_t>(stream.size()));
+    rc::PacketView packet;
+    std::size_t packets = 0;
+    while (decoder.Next(packet))
+    {
+      ++packets;
+    }
+    return packets;
+  }
+
+  // ======================================================================
+  // 벤치마크
+  // ======================================================================
+  void AddParseBenchmarks(const Options &options, std::vector<Result> &results, const std::string &suffix,
+                          const QByteArray &stream, const std::vector<QByteArray> &fragments)
+  {
+    const uint64_t packets = CountPackets(stream);
+
+    // rc::Parse(): 패킷마다 QByteArray를 만드는 기존 API
+    Run(options, results, "parse/" + suffix, packets, [&]()
+                          {
+                            QByteArray buffer;
+                            for (const QByteArray &fragment : fragments)
+                            {
+                              buffer.append(fragment);
+                              DoNotOptimize(rc::Parse(buffer));
+                            } });
+
+    // PacketDecoder: HandleReadyRead가 쓰는 복사 없는 경로
+    Run(options, results, "decoder/" + suffix, packets, [&]()
+                          {
+                            static rc::PacketDecoder decoder;
+                            decoder.Clear();
+                            rc::PacketView packet;
+                            for (const QByteArray &fragment : fragments)
+                            {
+                              std::size_t offset = 0;
+                              while (offset < static_cast<std::size_t>(fragment.size()))
+                              {
+                                offset += decoder.Feed(fragment.constData() + offset,
+                                                       static_cast<std::size_t>(fragment.size()) - offset);
+                                while (decoder.Next(packet))
+                                {
+                                  DoNotOptimize(packet.command);
+                                }
+                              }
+                            } });
+  }
+
+  /// USB 오류 직후처럼 긴 잡음 구간 뒤에 패킷이 오는 경우. 항목 단위는 바이트입니다.
+  void AddResyncBenchmarks(const Options &options, std::vector<Result> &results,
+                           const QByteArray &clean, std::mt19937 &rng)
+  {
+    std::uniform_int_distribution<int> byte(0, 255);
+    QByteArray stream;
+    for (int i = 0; i < 16 * 1024; ++i)
+    {
+      // 0xFE도 섞이지만 연속된 0xFE 0xFE는 드물게만 나옵니다.
+      stream.append(static_cast<char>(byte(rng)));
+    }
+    stream.append(clean);
+
+    Run(options, results, "decoder/garbage_run", static_cast<uint64_t>(stream.size()), [&]()
+        {
+          static rc::PacketDecoder decoder;
+          decoder.Clear();
+          rc::PacketView packet;
+          std::size_t offset = 0;
+          while (offset < static_cast<std::size_t>(stream.size()))
+          {
+            offset += decoder.Feed(stream.constData() + offset, std::min<std::size_t>(512, static_cast<std::size_t>(stream.size()) - offset));
+            while (decoder.Next(packet))
+            {
+              DoNotOptimize(packet.command);
+            }
+          } });
+  }
+
+  void AddDecodeBenchmarks(const Options &options, std::vector<Result> &results, std::mt19937 &rng)
+  {
+    using namespace rc::field;
+    const auto angles_frame = rc::FrameSpec<rc::Command::GetAngles, I16Array<100, rc::Joints>>::Encode(SampleAngles(rng));
+    const auto coords_frame = rc::FrameSpec<rc::Command::GetCoords, CoordsI16>::Encode(SampleCoords(rng));
+    const rc::PacketView angles_packet{rc::Command::GetAngles,
+                                       reinterpret_cast<const unsigned char *>(angles_frame.data()) + 4, 12};
+    const rc::PacketView coords_packet{rc::Command::GetCoords,
+                                       reinterpret_cast<const unsigned char *>(coords_frame.data()) + 4, 12};
+
+    // DispatchPacket의 GetAngles/GetCoords 분기와 같은 변환
+    Run(options, results, "decode_int16/angles", 1, [&]()
+                          {
+                            rc::Angles angles{};
+                            for (std::size_t i = 0; i < rc::Joints; ++i)
+                            {
+                              angles[i] = static_cast<double>(angles_packet.Int16(i * 2)) / 100.0;
+                            }
+                            DoNotOptimize(angles); });
+    Run(options, results, "decode_int16/coords", 1, [&]()
+                          {
+                            rc::Coords coords{};
+                            for (std::size_t i = 0; i < 3; ++i)
+                            {
+                              coords[i] = static_cast<double>(coords_packet.Int16(i * 2)) / 10.0;
+                            }
+                            for (std::size_t i = 3; i < rc::Axes; ++i)
+                            {
+                              coords[i] = static_cast<double>(coords_packet.Int16(i * 2)) / 100.0;
+                            }
+                            DoNotOptimize(coords); });
+  }
+
+  void AddEncodeBenchmarks(const Options &options, std::vector<Result> &results, std::mt19937 &rng)
+  {
+    const rc::Angles angles = SampleAngles(rng);
+    const rc::Coords coords = SampleCoords(rng);
+
+    Run(options, results, "encode/write_angles", 1, [&]()
+                          { DoNotOptimize(rc::frames::WriteAngles::Encode(angles, 50)); });
+    Run(options, results, "encode/write_coords", 1, [&]()
+                          { DoNotOptimize(rc::frames::WriteCoords::Encode(coords, 50, 1)); });
+    Run(options, results, "encode/get_servo_data", 1, [&]()
+                          { DoNotOptimize(rc::frames::GetServoData16::Encode(1, 60, 1)); }); // 60: 부하 주소
+  }
+
+  void AddCommonBenchmarks(const Options &options, std::vector<Result> &results, std::mt19937 &rng)
+  {
+    const rc::Coords coords = SampleCoords(rng);
+    const std::string coords_string = rc::CoordsToString(coords);
+
+    Run(options, results, "common/coords_to_string", 1, [&]()
+                          { DoNotOptimize(rc::CoordsToString(coords)); });
+    Run(options, results, "common/string_to_coords", 1, [&]()
+                          { DoNotOptimize(rc::StringToCoords(coords_string)); });
+    Run(options, results, "common/coords_to_gcode", 1, [&]()
+                          { DoNotOptimize(rc::CoordsToGcode(coords)); });
+    Run(options, results, "common/is_coords_zero", 1, [&]()
+                          { DoNotOptimize(rc::IsCoordsZero(coords)); });
+  }
+
+  void WriteJson(std::ostream &out, const std::vector<Result> &results)
+  {
+    out << "{\n  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+      const Result &r = results[i];
+      out << "    {\"name\": \"" << r.name << "\", \"iterations\": " << r.iterations
+          << ", \"items\": " << r.items << ", \"ns_per_item\": " << r.ns_per_item
+          << ", \"allocs_per_item\": " << r.allocs_per_item << "}"
+          << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Options options;
+  for (int i = 1; i + 1 < argc; i += 2)
+  {
+    const std::string arg = argv[i];
+    if (arg == "--filter")
+    {
+      options.filter = argv[i + 1];
+    }
+    else if (arg == "--min-time-ms")
+    {
+      options.min_time = std::chrono::milliseconds{std::stol(argv[i + 1])};
+    }
+    else if (arg == "--out")
+    {
+      options.out = argv[i + 1];
+    }
+    else
+    {
+      std::cerr << "사용법: " << argv[0] << " [--filter SUBSTR] [--min-time-ms N] [--out FILE]" << std::endl;
+      return 1;
+    }
+  }
+
+  rc::InitFirmata();
+
+  // 고정 시드: 릴리스 간 결과를 비교할 수 있도록 같은 입력을 씁니다.
+  std::mt19937 rng(20240601);
+  const QByteArray clean = CleanStream(rng);
+  const QByteArray noisy = NoisyStream(clean, rng);
+
+  std::vector<Result> results;
+  AddParseBenchmarks(options, results, "clean", clean, {clean});
+  AddParseBenchmarks(options, results, "fragmented", clean, Fragment(clean, rng));
+  AddParseBenchmarks(options, results, "noisy", noisy, Fragment(noisy, rng));
+  AddResyncBenchmarks(options, results, clean, rng);
+  AddDecodeBenchmarks(options, results, rng);
+  AddEncodeBenchmarks(options, results, rng);
+  AddCommonBenchmarks(options, results, rng);
+
+  if (options.out.empty())
+  {
+    WriteJson(std::cout, results);
+  }
+  else
+  {
+    std::ofstream file(options.out);
+    WriteJson(file, results);
+  }
+  return 0;
+}
@@ -0,0 +1,290 @@
+/**
+ * @file PacketDecoderTest.cpp
+ * @brief PacketDecoder(memchr 헤더 탐색)가 기존 MyCobot::Parse 규칙과 같은 패킷을 꺼내는지 확인합니다.
+ *
+ * 고정 사례(나뉜 헤더, 버퍼 끝의 FE, 페이로드 안의 가짜 FE FE)와 무작위 스트림 fuzzer로
+ * 참조 구현과 결과를 비교합니다. 실패한 검사마다 한 줄을 출력하고, 하나라도 실패하면 1을 반환합니다. (ctest)
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "PacketDecoder.hpp"
+
+namespace
+{
+    int failures = 0;
+
+    void Check(bool condition, const char *what)
+    {
+        if (!condition)
+        {
+            std::cerr << "FAIL: " << what << std::endl;
+            ++failures;
+        }
+    }
+
+    using Bytes = std::vector<unsigned char>;
+
+    struct Packet
+    {
+        unsigned char command{0};
+        Bytes data{};
+
+        bool operator==(const Packet &other) const { return command == other.command && data == other.data; }
+    };
+
+    /**
+     * @brief 참조 구현: 기존 MyCobot::Parse의 규칙을 그대로 옮긴 것입니다.
+     * PacketDecoder와 의도적으로 다른 두 가지만 맞췄습니다.
+     *   - 헤더가 없을 때 마지막 0xFE는 다음 헤더의 첫 바이트일 수 있으므로 남깁니다.
+     *   - LEN이 2보다 작으면 페이로드는 비어 있습니다.
+     */
+    void ReferenceParse(Bytes &data, std::vector<Packet> &packets)
+    {
+        const unsigned char header[2] = {0xFE, 0xFE};
+        while (data.size() >= 4)
+        {
+            const auto head = std::search(data.begin(), data.end(), header, header + 2);
+            if (head == data.end())
+            {
+                const std::size_t keep = data.back() == 0xFE ? 1 : 0;
+                data.erase(data.begin(), data.end() - static_cast<std::ptrdiff_t>(keep));
+                return;
+            }
+            data.erase(data.begin(), head);
+
+            if (data.size() < 3)
+            {
+                break;
+            }
+            const std::size_t len_field = data[2];
+            const std::size_t total_packet_len = len_field + 3;
+            if (data.size() < total_packet_len)
+            {
+                break;
+            }
+            if (data[total_packet_len - 1] == 0xFA)
+            {
+                Packet packet;
+                packet.command = data[3];
+                if (len_field >= 2)
+                {
+                    packet.data.assign(data.begin() + 4, data.begin() + 4 + static_cast<std::ptrdiff_t>(len_field - 2));
+                }
+                packets.push_back(packet);
+                data.erase(data.begin(), data.begin() + static_cast<std::ptrdiff_t>(total_packet_len));
+            }
+            else
+            {
+                data.erase(data.begin());
+            }
+        }
+    }
+
+    /// MyCobot::FeedReceivedBytes와 같이 받아들일 수 있는 만큼 넣고 패킷을 꺼내기를 반복합니다.
+    void Decode(rc::PacketDecoder &decoder, const Bytes &chunk, std::vector<Packet> &packets)
+    {
+        const char *data = reinterpret_cast<const char *>(chunk.data());
+        std::size_t offset = 0;
+        while (offset < chunk.size())
+        {
+            offset += decoder.Feed(data + offset, chunk.size() - offset);
+            rc::PacketView view;
+            while (decoder.Next(view))
+            {
+                packets.push_back({view.command, Bytes(view.data, view.data + view.size)});
+            }
+        }
+    }
+
+    /// chunks를 차례로 넣어 PacketDecoder와 참조 구현의 결과를 비교합니다.
+    bool SameAsReference(const std::vector<Bytes> &chunks, std::size_t capacity, std::vector<Packet> *decoded = nullptr)
+    {
+        rc::PacketDecoder decoder(capacity);
+        std::vector<Packet> actual;
+        Bytes pending;
+        std::vector<Packet> expected;
+        for (const Bytes &chunk : chunks)
+        {
+            Decode(decoder, chunk, actual);
+            pending.insert(pending.end(), chunk.begin(), chunk.end());
+            ReferenceParse(pending, expected);
+        }
+        if (decoded)
+        {
+            *decoded = actual;
+        }
+        return actual == expected && decoder.Size() == pending.size() && decoder.Stats().packets == actual.size();
+    }
+
+    Bytes Frame(unsigned char command, const Bytes &data)
+    {
+        Bytes frame = {0xFE, 0xFE, static_cast<unsigned char>(data.size() + 2), command};
+        frame.insert(frame.end(), data.begin(), data.end());
+        frame.push_back(0xFA);
+        return frame;
+    }
+
+    Bytes Concat(std::initializer_list<Bytes> parts)
+    {
+        Bytes out;
+        for (const Bytes &part : parts)
+        {
+            out.insert(out.end(), part.begin(), part.end());
+        }
+        return out;
+    }
+
+    /// 헤더/푸터 바이트가 자주 나오는 무작위 바이트
+    unsigned char NoiseByte(std::mt19937 &rng)
+    {
+        static const unsigned char special[] = {0xFE, 0xFE, 0xFA, 0x00, 0x01, 0x02, 0x05};
+        std::uniform_int_distribution<int> pick(0, 3);
+        if (pick(rng) == 0)
+        {
+            return static_cast<unsigned char>(std::uniform_int_distribution<int>(0, 255)(rng));
+        }
+        return special[std::uniform_int_distribution<std::size_t>(0, sizeof(special) - 1)(rng)];
+    }
+
+    /// 유효한 패킷, 잡음, 잘린 패킷, 푸터가 틀린 가짜 패킷을 섞은 스트림
+    Bytes RandomStream(std::mt19937 &rng, std::size_t target_size)
+    {
+        Bytes stream;
+        std::uniform_int_distribution<int> kind(0, 9);
+        while (stream.size() < target_size)
+        {
+            const int k = kind(rng);
+            if (k < 5)
+            {
+                Bytes data(std::uniform_int_distribution<std::size_t>(0, k == 0 ? 253 : 12)(rng));
+                for (unsigned char &b : data)
+                {
+                    b = NoiseByte(rng);
+                }
+                const Bytes frame = Frame(NoiseByte(rng), data);
+                stream.insert(stream.end(), frame.begin(), frame.end());
+            }
+            else if (k < 8)
+            {
+                const std::size_t n = std::uniform_int_distribution<std::size_t>(1, 16)(rng);
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    stream.push_back(NoiseByte(rng));
+                }
+            }
+            else
+            {
+                // 잘렸거나 푸터가 틀린 패킷 (가짜 헤더)
+                Bytes frame = Frame(NoiseByte(rng), Bytes(std::uniform_int_distribution<std::size_t>(0, 8)(rng), 0x11));
+                if (k == 8)
+                {
+                    frame.back() = 0x00;
+                }
+                else
+                {
+                    frame.resize(std::uniform_int_distribution<std::size_t>(1, frame.size() - 1)(rng));
+                }
+                stream.insert(stream.end(), frame.begin(), frame.end());
+            }
+        }
+        return stream;
+    }
+
+    std::vector<Bytes> RandomChunks(std::mt19937 &rng, const Bytes &stream, std::size_t max_chunk)
+    {
+        std::vector<Bytes> chunks;
+        std::size_t offset = 0;
+        while (offset < stream.size())
+        {
+            const std::size_t n = std::min(std::uniform_int_distribution<std::size_t>(1, max_chunk)(rng), stream.size() - offset);
+            chunks.emplace_back(stream.begin() + static_cast<std::ptrdiff_t>(offset), stream.begin() + static_cast<std::ptrdiff_t>(offset + n));
+            offset += n;
+        }
+        return chunks;
+    }
+}
+
+int main()
+{
+    const Bytes angles = Frame(0x20, {0x01, 0x02, 0x03, 0x04});
+    std::vector<Packet> decoded;
+
+    // 1. 두 수신 덩어리에 나뉜 헤더: 첫 덩어리는 잡음 + FE로 끝나고, 두 번째 덩어리가 FE로 시작합니다.
+    {
+        const Bytes first = {0x11, 0x22, 0x33, 0x44, 0xFE};
+        const Bytes second(angles.begin() + 1, angles.end());
+        Check(SameAsReference({first, second}, rc::PacketDecoder::DefaultCapacity, &decoded), "split header differs from reference");
+        Check(decoded.size() == 1 && decoded.front().command == 0x20, "split header packet lost");
+    }
+
+    // 2. 버퍼 끝의 FE: 헤더가 없는 덩어리의 마지막 FE는 남고, 링의 끝을 넘는 헤더와 패킷도 꺼내집니다.
+    {
+        rc::PacketDecoder decoder(rc::PacketDecoder::MaxPacketSize);
+        const Bytes garbage = {0x10, 0x20, 0x30, 0xFE};
+        std::vector<Packet> packets;
+        Decode(decoder, garbage, packets);
+        Check(decoder.Size() == 1, "trailing FE not kept when no header was found");
+
+        // 링의 마지막 바이트가 헤더의 첫 FE가 되도록 채운 뒤 나머지를 넣습니다.
+        Bytes filler(rc::PacketDecoder::MaxPacketSize - 2, 0x33);
+        filler.push_back(0xFE);
+        Bytes rest(angles.begin() + 1, angles.end());
+        Check(SameAsReference({filler, rest}, rc::PacketDecoder::MaxPacketSize, &decoded), "header at ring end differs from reference");
+        Check(decoded.size() == 1 && decoded.front().data == Bytes({0x01, 0x02, 0x03, 0x04}), "packet across ring end lost");
+
+        std::mt19937 rng(1);
+        const Bytes wrapped = Concat({Bytes(rc::PacketDecoder::MaxPacketSize - 3, 0x44), angles, angles});
+        Check(SameAsReference(RandomChunks(rng, wrapped, 7), rc::PacketDecoder::MaxPacketSize, &decoded) && decoded.size() == 2,
+              "packets across ring end differ from reference");
+    }
+
+    // 3. 페이로드 안의 가짜 FE FE: 유효한 패킷은 하나로 꺼내지고, 푸터가 틀린 가짜 헤더 뒤에서는 다시 동기화합니다.
+    {
+        const Bytes tricky = Frame(0x21, {0xFE, 0xFE, 0x04, 0xFA, 0xFE});
+        Check(SameAsReference({tricky}, rc::PacketDecoder::DefaultCapacity, &decoded), "FE FE in payload differs from reference");
+        Check(decoded.size() == 1 && decoded.front().command == 0x21 && decoded.front().data.size() == 5, "FE FE in payload split the packet");
+
+        const Bytes fake = {0xFE, 0xFE, 0x05, 0x20, 0x00, 0x00, 0x00, 0x00};
+        rc::PacketDecoder decoder;
+        std::vector<Packet> packets;
+        Decode(decoder, Concat({fake, angles}), packets);
+        Check(packets.size() == 1 && packets.front().command == 0x20, "packet after a false header lost");
+        Check(decoder.Stats().resyncs >= 1, "false header not counted as a resync");
+        Check(SameAsReference({Concat({fake, angles})}, rc::PacketDecoder::DefaultCapacity), "false header differs from reference");
+    }
+
+    // 4. 무작위 스트림 fuzzer: 여러 덩어리 크기와 버퍼 크기에서 참조 구현과 같아야 합니다.
+    {
+        std::mt19937 rng(20240521);
+        bool mismatch = false;
+        for (int round = 0; round < 400 && !mismatch; ++round)
+        {
+            const Bytes stream = RandomStream(rng, 2048);
+            for (const std::size_t capacity : {rc::PacketDecoder::MaxPacketSize, std::size_t{1024}, rc::PacketDecoder::DefaultCapacity})
+            {
+                for (const std::size_t max_chunk : {std::size_t{1}, std::size_t{7}, std::size_t{64}, std::size_t{600}})
+                {
+                    if (!mismatch && !SameAsReference(RandomChunks(rng, stream, max_chunk), capacity))
+                    {
+                        // 첫 불일치만 알립니다.
+                        std::cerr << "round " << round << ", capacity " << capacity << ", max chunk " << max_chunk << ":" << std::endl;
+                        Check(false, "random stream differs from reference");
+                        mismatch = true;
+                    }
+                }
+            }
+        }
+    }
+
+    if (failures == 0)
+    {
+        std::cout << "PacketDecoderTest: OK" << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
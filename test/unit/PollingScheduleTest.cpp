@@ -0,0 +1,91 @@
+/**
+ * @file PollingScheduleTest.cpp
+ * @brief PollingSchedule 컴파일 결과가 요청 주파수와 링크 예산을 넘지 않는지 확인합니다.
+ *
+ * 실패한 검사마다 한 줄을 출력하고, 하나라도 실패하면 1을 반환합니다. (ctest)
+ */
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "PollingSchedule.hpp"
+
+namespace
+{
+    int failures = 0;
+
+    void Check(bool condition, const char *what, double requested_hz, double actual)
+    {
+        if (!condition)
+        {
+            std::cerr << "FAIL: " << what << " (requested " << requested_hz << " Hz, got " << actual << ")" << std::endl;
+            ++failures;
+        }
+    }
+
+    /// 틱과 divisor로 계산한 실제 주파수
+    double ScheduledHz(const rc::PollingSchedule &schedule, const rc::PollingSchedule::Slot &slot)
+    {
+        return 1000.0 / (static_cast<double>(slot.divisor) * static_cast<double>(schedule.Tick().count()));
+    }
+
+    void CheckNotFaster(double rate_hz, int baud_rate, double link_budget)
+    {
+        const std::vector<rc::PollingEntry> plan = {
+            {rc::RequestType::REQ_Angles, rc::J1, rate_hz},
+            {rc::RequestType::REQ_IsMoving, rc::J1, rate_hz / 3.0},
+            {rc::RequestType::REQ_Loads, rc::J3, rate_hz / 7.0},
+            {rc::RequestType::REQ_Voltages, rc::J1, 1.0},
+        };
+        rc::PollingSchedule schedule;
+        schedule.Compile(plan, std::chrono::milliseconds{50}, baud_rate, link_budget);
+
+        for (const rc::PollingSchedule::Slot &slot : schedule.Entries())
+        {
+            const double actual = ScheduledHz(schedule, slot);
+            Check(actual <= slot.requested_hz * (1.0 + 1e-9), "compiled rate above requested rate", slot.requested_hz, actual);
+            Check(slot.entry.rate_hz <= slot.requested_hz * (1.0 + 1e-9), "reported rate above requested rate", slot.requested_hz, slot.entry.rate_hz);
+        }
+        Check(schedule.EstimatedUtilization() <= link_budget * (1.0 + 1e-9), "utilization above link budget", rate_hz,
+              schedule.EstimatedUtilization());
+    }
+}
+
+int main()
+{
+    // 주기가 ms로 나누어 떨어지지 않는 주파수 (300 Hz -> 3.33 ms, 60 Hz -> 16.7 ms)
+    for (const double rate_hz : {300.0, 333.0, 250.0, 120.0, 60.0, 50.0, 33.0, 20.0, 7.0})
+    {
+        CheckNotFaster(rate_hz, 1000000, 0.5);
+        // 예산 때문에 주파수를 낮추는 경우에도 양자화 후 예산을 넘지 않아야 합니다.
+        CheckNotFaster(rate_hz, 115200, 0.5);
+        CheckNotFaster(rate_hz, 115200, 0.1);
+    }
+
+    // 단일 300 Hz 요청
+    rc::PollingSchedule schedule;
+    schedule.Compile({{rc::RequestType::REQ_Angles, rc::J1, 300.0}}, std::chrono::milliseconds{50}, 1000000, 1.0);
+    Check(!schedule.Entries().empty() && ScheduledHz(schedule, schedule.Entries().front()) <= 300.0,
+          "300 Hz request compiled above 300 Hz", 300.0,
+          schedule.Entries().empty() ? 0.0 : ScheduledHz(schedule, schedule.Entries().front()));
+
+    // 적응형 폴링: staleness budget(50 ms)은 틱의 상한일 뿐, 100 Hz 계획과 빠른 컨트롤러 주기는 10 ms 틱이 됩니다.
+    {
+        const std::chrono::milliseconds budget{50};
+        rc::PollingSchedule adaptive;
+        adaptive.Compile({{rc::RequestType::REQ_Angles, rc::J1, 100.0}}, std::chrono::milliseconds{50}, 1000000, 0.5);
+        Check(adaptive.Tick() == std::chrono::milliseconds{10}, "100 Hz plan not compiled to a 10 ms tick", 100.0,
+              1000.0 / static_cast<double>(adaptive.Tick().count()));
+        const auto fast = rc::PollingSchedule::AdaptiveTick(std::chrono::microseconds{9500}, budget);
+        Check(fast == std::chrono::milliseconds{10}, "adaptive tick held at the staleness budget", 100.0, 1000.0 / static_cast<double>(fast.count()));
+        const auto slow = rc::PollingSchedule::AdaptiveTick(std::chrono::milliseconds{80}, budget);
+        Check(slow == budget, "adaptive tick above the staleness budget", 20.0, 1000.0 / static_cast<double>(slow.count()));
+    }
+
+    if (failures == 0)
+    {
+        std::cout << "PollingScheduleTest: OK" << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
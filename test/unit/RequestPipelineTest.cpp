@@ -0,0 +1,123 @@
+/**
+ * @file RequestPipelineTest.cpp
+ * @brief 응답에 관절 번호가 없는 GetServoData 요청이 다른 관절의 응답과 짝지어지지 않는지 확인합니다.
+ *
+ * 실패한 검사마다 한 줄을 출력하고, 하나라도 실패하면 1을 반환합니다. (ctest)
+ */
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "Firmata.hpp"
+#include "RequestPipeline.hpp"
+
+namespace
+{
+    int failures = 0;
+
+    void Check(bool condition, const char *what)
+    {
+        if (!condition)
+        {
+            std::cerr << "FAIL: " << what << std::endl;
+            ++failures;
+        }
+    }
+
+    using Clock = rc::RequestPipeline::Clock;
+    using std::chrono::milliseconds;
+}
+
+int main()
+{
+    const Clock::time_point t0 = Clock::now();
+
+    // 1. window가 3이어도 GetServoData는 한 번에 하나만 in-flight
+    {
+        rc::RequestPipeline pipeline;
+        for (int joint = rc::J1; joint <= rc::J6; ++joint)
+        {
+            pipeline.Enqueue(rc::RequestType::REQ_Loads, static_cast<rc::Joint>(joint));
+        }
+        pipeline.Enqueue(rc::RequestType::REQ_Voltages, rc::J1);
+        rc::PendingRequest request;
+        int loads_sent = 0;
+        while (pipeline.Dispatch(t0, request))
+        {
+            loads_sent += request.type == rc::RequestType::REQ_Loads ? 1 : 0;
+        }
+        Check(loads_sent == 1, "more than one GetServoData in flight");
+        Check(pipeline.InFlightCount() == 2, "other requests should still use the window");
+
+        // 응답이 오면 다음 관절을 보냅니다.
+        rc::PendingRequest matched;
+        Check(pipeline.Complete(rc::Command::GetServoData, matched) && matched.joint == rc::J1, "J1 reply not matched to J1");
+        Check(pipeline.Dispatch(t0, request) && request.joint == rc::J2, "J2 not sent after J1 reply");
+    }
+
+    // 2. 타임아웃 후 늦게 온 J1 응답은 J2와 짝지어지지 않습니다.
+    {
+        rc::RequestPipeline pipeline;
+        pipeline.Enqueue(rc::RequestType::REQ_Loads, rc::J1);
+        pipeline.Enqueue(rc::RequestType::REQ_Loads, rc::J2);
+        rc::PendingRequest request;
+        Check(pipeline.Dispatch(t0, request) && request.joint == rc::J1, "J1 not sent first");
+
+        const Clock::time_point expired_at = t0 + rc::RequestPipeline::DefaultTimeout + milliseconds{1};
+        Check(pipeline.ExpireTimedOut(expired_at) == 1, "J1 did not time out");
+        Check(pipeline.ResyncCount() == 1, "timeout did not start a resync");
+        Check(!pipeline.Dispatch(expired_at, request), "GetServoData sent during resync");
+
+        // 재동기화 중에 온 늦은 J1 응답: 짝이 없어야 합니다.
+        rc::PendingRequest matched;
+        Check(!pipeline.Complete(rc::Command::GetServoData, matched), "late J1 reply matched a request");
+
+        // 재동기화가 끝나면 재시도한 J1, 그다음 J2 순서로 보냅니다.
+        const Clock::time_point resumed_at = expired_at + rc::RequestPipeline::DefaultTimeout;
+        Check(pipeline.Dispatch(resumed_at, request) && request.joint == rc::J1 && request.attempt == 1, "J1 retry not sent after resync");
+        Check(pipeline.Complete(rc::Command::GetServoData, matched) && matched.joint == rc::J1, "J1 retry reply not matched to J1");
+        Check(pipeline.Dispatch(resumed_at, request) && request.joint == rc::J2, "J2 not sent after J1 retry");
+    }
+
+    // 3. 직접 보낸 요청(동기 GetServoData)은 부하 요청이 in-flight이면 등록되지 않고, 등록되면 부하 요청을 막습니다.
+    {
+        rc::RequestPipeline pipeline;
+        pipeline.Enqueue(rc::RequestType::REQ_Loads, rc::J3);
+        rc::PendingRequest request;
+        Check(pipeline.Dispatch(t0, request), "J3 not sent");
+        Check(!pipeline.TrackExternal(rc::RequestType::REQ_Loads, rc::J1, t0, milliseconds{1000}), "external request tracked while a load request is in flight");
+
+        rc::PendingRequest matched;
+        Check(pipeline.Complete(rc::Command::GetServoData, matched) && !matched.external, "J3 reply not matched to J3");
+        Check(pipeline.TrackExternal(rc::RequestType::REQ_Loads, rc::J1, t0, milliseconds{1000}), "external request not tracked on an idle pipeline");
+        pipeline.Enqueue(rc::RequestType::REQ_Loads, rc::J4);
+        Check(!pipeline.Dispatch(t0, request), "load request sent while an external GetServoData is in flight");
+        Check(pipeline.Complete(rc::Command::GetServoData, matched) && matched.external, "external reply not matched to the external request");
+        Check(pipeline.Dispatch(t0, request) && request.joint == rc::J4, "J4 not sent after the external reply");
+    }
+
+    // 4. 재생한 송신 프레임: 응답은 프레임의 관절과 짝지어지고, 응답이 없던 요청은 타임아웃 뒤 짝지어지지 않습니다.
+    {
+        rc::RequestPipeline pipeline;
+        pipeline.SetMaxRetries(0);
+        Check(!pipeline.TrackReplayed(rc::Command::Undefined, rc::J1, t0), "command without a reply tracked");
+        Check(pipeline.TrackReplayed(rc::Command::GetServoData, rc::J5, t0), "replayed GetServoData not tracked");
+        rc::PendingRequest matched;
+        Check(pipeline.Complete(rc::Command::GetServoData, matched) && matched.joint == rc::J5 && matched.type == rc::RequestType::REQ_Loads,
+              "replayed reply not matched to the captured joint");
+
+        Check(pipeline.TrackReplayed(rc::Command::GetServoData, rc::J2, t0), "replayed GetServoData not tracked");
+        const Clock::time_point later = t0 + rc::RequestPipeline::DefaultTimeout + milliseconds{1};
+        pipeline.ExpireTimedOut(later);
+        Check(pipeline.TrackReplayed(rc::Command::GetServoData, rc::J3, later), "replayed GetServoData not tracked during resync");
+        Check(pipeline.Complete(rc::Command::GetServoData, matched) && matched.joint == rc::J3, "reply matched to an unanswered replayed request");
+        Check(pipeline.QueuedCount() == 0, "replayed request retried");
+    }
+
+    if (failures == 0)
+    {
+        std::cout << "RequestPipelineTest: OK" << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
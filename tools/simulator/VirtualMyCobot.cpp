@@ -0,0 +1,478 @@
+#include "VirtualMyCobot.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "FrameEncoder.hpp"
+
+namespace rc
+{
+
+    namespace
+    {
+        constexpr double InPositionAngleTolerance = 1.0; // deg
+        constexpr double EncoderCenter = 2048.0;
+        constexpr double EncoderPerDegree = 4096.0 / 360.0;
+        constexpr int ServoVoltage = 74; // 7.4V (x10)
+        constexpr int ServoLoad = 12;
+
+        // 응답 프레임 레이아웃
+        using namespace field;
+        using AnglesReply = FrameSpec<Command::GetAngles, I16Array<100, Joints>>;
+        using CoordsReply = FrameSpec<Command::GetCoords, CoordsI16>;
+        using EncodersReply = FrameSpec<Command::GetEncoders, I16Array<1, Joints>>;
+        using SpeedsReply = FrameSpec<Command::GET_SERVO_SPEEDS, I16Array<1, Joints>>;
+        using VoltagesReply = FrameSpec<Command::GET_SERVO_VOLTAGES, U8, U8, U8, U8, U8, U8>;
+        using ServoData8Reply = FrameSpec<Command::GetServoData, U8>;
+        using ServoData16Reply = FrameSpec<Command::GetServoData, I16<1>>;
+        using ServoEnabledReply = FrameSpec<Command::IsServoEnabled, U8, U8>;
+        template <Command Cmd>
+        using FlagReply = FrameSpec<Cmd, U8>;
+
+        double MoveToward(double current, double target, double max_step)
+        {
+            const double delta = target - current;
+            if (std::fabs(delta) <= max_step)
+            {
+                return target;
+            }
+            return current + std::copysign(max_step, delta);
+        }
+
+        void ThrowErrno(const char *what)
+        {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+    }
+
+    VirtualMyCobot::VirtualMyCobot(SimulatorConfig config_)
+        : config(std::move(config_))
+    {
+        coords = {150.0, 0.0, 300.0, -180.0, 0.0, 0.0};
+        target_coords = coords;
+        joint_speed = config.max_joint_speed * speed_percent / 100.0;
+        linear_speed = config.max_linear_speed * speed_percent / 100.0;
+    }
+
+    VirtualMyCobot::~VirtualMyCobot()
+    {
+        Stop();
+    }
+
+    void VirtualMyCobot::Start()
+    {
+        if (IsRunning())
+        {
+            return;
+        }
+
+        master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+        if (master_fd < 0)
+        {
+            ThrowErrno("posix_openpt");
+        }
+        if (grantpt(master_fd) != 0 || unlockpt(master_fd) != 0)
+        {
+            const int saved = errno;
+            close(master_fd);
+            master_fd = -1;
+            throw std::system_error(saved, std::generic_category(), "grantpt/unlockpt");
+        }
+        slave_path = ptsname(master_fd);
+
+        // 클라이언트(QSerialPort)가 다시 설정하기 전까지도 바이트가 변환되지 않도록 raw 모드로 둡니다.
+        slave_fd = open(slave_path.c_str(), O_RDWR | O_NOCTTY);
+        if (slave_fd >= 0)
+        {
+            termios tio{};
+            if (tcgetattr(slave_fd, &tio) == 0)
+            {
+                cfmakeraw(&tio);
+                tcsetattr(slave_fd, TCSANOW, &tio);
+            }
+        }
+        fcntl(master_fd, F_SETFL, fcntl(master_fd, F_GETFL) | O_NONBLOCK);
+
+        if (!config.link_path.empty())
+        {
+            unlink(config.link_path.c_str());
+            if (symlink(slave_path.c_str(), config.link_path.c_str()) != 0)
+            {
+                const int saved = errno;
+                Stop();
+                throw std::system_error(saved, std::generic_category(), "symlink " + config.link_path);
+            }
+        }
+
+        decoder.Clear();
+        outgoing.clear();
+        last_step = line_free_at = Clock::now();
+        stop_requested.store(false, std::memory_order_release);
+        running.store(true, std::memory_order_release);
+        thread = std::thread(&VirtualMyCobot::Run, this);
+    }
+
+    void VirtualMyCobot::Stop()
+    {
+        stop_requested.store(true, std::memory_order_release);
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+        running.store(false, std::memory_order_release);
+        if (!config.link_path.empty())
+        {
+            unlink(config.link_path.c_str());
+        }
+        if (slave_fd >= 0)
+        {
+            close(slave_fd);
+            slave_fd = -1;
+        }
+        if (master_fd >= 0)
+        {
+            close(master_fd);
+            master_fd = -1;
+        }
+    }
+
+    std::string VirtualMyCobot::PortName() const
+    {
+        return config.link_path.empty() ? slave_path : config.link_path;
+    }
+
+    SimulatorStats VirtualMyCobot::Stats() const
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        return stats;
+    }
+
+    std::array<double, 6> VirtualMyCobot::CurrentAngles() const
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        return angles;
+    }
+
+    std::array<double, 6> VirtualMyCobot::CurrentCoords() const
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        return coords;
+    }
+
+    void VirtualMyCobot::Run()
+    {
+        while (!stop_requested.load(std::memory_order_acquire))
+        {
+            const Clock::time_point now = Clock::now();
+            const auto wait = std::chrono::duration_cast<std::chrono::nanoseconds>(NextWakeup(now) - now);
+
+            pollfd pfd{master_fd, POLLIN, 0};
+            timespec timeout{};
+            timeout.tv_sec = static_cast<time_t>(wait.count() / 1000000000);
+            timeout.tv_nsec = static_cast<long>(wait.count() % 1000000000);
+            const int ready = ppoll(&pfd, 1, &timeout, nullptr);
+            if (ready < 0 && errno != EINTR)
+            {
+                break;
+            }
+            if (ready > 0 && (pfd.revents & POLLIN))
+            {
+                ReadInput();
+            }
+
+            const Clock::time_point after = Clock::now();
+            Step(after);
+            FlushOutput(after);
+        }
+    }
+
+    VirtualMyCobot::Clock::time_point VirtualMyCobot::NextWakeup(Clock::time_point now) const
+    {
+        Clock::time_point wakeup = last_step + config.tick;
+        if (!outgoing.empty())
+        {
+            wakeup = std::min(wakeup, outgoing.front().due);
+        }
+        return std::max(wakeup, now);
+    }
+
+    void VirtualMyCobot::Enqueue(const char *data, std::size_t size, Clock::time_point now)
+    {
+        // 응답 지연이 지난 뒤 선로가 비면 전송을 시작하고, 마지막 바이트가 도착하는 시각에 씁니다.
+        Clock::time_point start = std::max(now + config.response_latency, line_free_at);
+        if (config.baud_rate > 0)
+        {
+            // 8N1: 바이트당 10비트
+            const auto on_wire = std::chrono::nanoseconds{
+                static_cast<int64_t>(size) * 10 * 1000000000 / config.baud_rate};
+            start += std::chrono::duration_cast<Clock::duration>(on_wire);
+        }
+        line_free_at = start;
+        outgoing.push_back({start, std::vector<char>(data, data + size)});
+    }
+
+    void VirtualMyCobot::ReadInput()
+    {
+        char chunk[512];
+        ssize_t bytes_read = 0;
+        while ((bytes_read = read(master_fd, chunk, sizeof(chunk))) > 0)
+        {
+            const Clock::time_point now = Clock::now();
+            std::lock_guard<std::mutex> lock(state_mutex);
+            stats.bytes_received += static_cast<uint64_t>(bytes_read);
+
+            std::size_t offset = 0;
+            while (offset < static_cast<std::size_t>(bytes_read))
+            {
+                offset += decoder.Feed(chunk + offset, static_cast<std::size_t>(bytes_read) - offset);
+                PacketView packet;
+                while (decoder.Next(packet))
+                {
+                    ++stats.frames_received;
+                    HandleCommand(packet, now);
+                }
+            }
+        }
+    }
+
+    void VirtualMyCobot::HandleCommand(const PacketView &packet, Clock::time_point now)
+    {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wswitch-enum"
+        switch (static_cast<Command>(packet.command))
+        {
+        // --- 상태 조회 ---
+        case Command::IsPoweredOn:
+            Reply(FlagReply<Command::IsPoweredOn>::Encode(powered_on ? 1 : 0), now);
+            break;
+        case Command::IsProgramPaused:
+            Reply(FlagReply<Command::IsProgramPaused>::Encode(paused ? 1 : 0), now);
+            break;
+        case Command::IsAllServoEnabled:
+            Reply(FlagReply<Command::IsAllServoEnabled>::Encode(servos_enabled ? 1 : 0), now);
+            break;
+        case Command::IsServoEnabled:
+            if (packet.size >= 1)
+            {
+                Reply(ServoEnabledReply::Encode(packet.At(0), servos_enabled ? 1 : 0), now);
+            }
+            break;
+        case Command::CheckRunning:
+        {
+            const bool moving = angles != target_angles || coords != target_coords;
+            Reply(FlagReply<Command::CheckRunning>::Encode(moving && !paused ? 1 : 0), now);
+            break;
+        }
+        case Command::IsInPosition:
+        {
+            if (packet.size < 13)
+            {
+                break;
+            }
+            const bool is_linear = packet.At(12) != 0;
+            bool in_position = true;
+            for (std::size_t i = 0; i < 6; ++i)
+            {
+                if (is_linear)
+                {
+                    const double value = packet.Int16(i * 2) / (i < 3 ? 10.0 : 100.0);
+                    in_position = in_position && std::fabs(value - coords[i]) <= CoordsEpsilon;
+                }
+                else
+                {
+                    const double value = packet.Int16(i * 2) / 100.0;
+                    in_position = in_position && std::fabs(value - angles[i]) <= InPositionAngleTolerance;
+                }
+            }
+            Reply(FlagReply<Command::IsInPosition>::Encode(in_position ? 1 : 0), now);
+            break;
+        }
+        case Command::GetAngles:
+            Reply(AnglesReply::Encode(angles), now);
+            break;
+        case Command::GetCoords:
+            Reply(CoordsReply::Encode(coords), now);
+            break;
+        case Command::GetEncoders:
+        {
+            std::array<double, 6> encoders{};
+            for (std::size_t i = 0; i < 6; ++i)
+            {
+                encoders[i] = EncoderCenter + angles[i] * EncoderPerDegree;
+            }
+            Reply(EncodersReply::Encode(encoders), now);
+            break;
+        }
+        case Command::GET_SERVO_SPEEDS:
+        {
+            // 서보 속도 단위(step/s)로 보냅니다.
+            std::array<double, 6> speeds{};
+            for (std::size_t i = 0; i < 6; ++i)
+            {
+                speeds[i] = joint_velocity[i] * EncoderPerDegree;
+            }
+            Reply(SpeedsReply::Encode(speeds), now);
+            break;
+        }
+        case Command::GET_SERVO_VOLTAGES:
+            Reply(VoltagesReply::Encode(ServoVoltage, ServoVoltage, ServoVoltage,
+                                        ServoVoltage, ServoVoltage, ServoVoltage),
+                  now);
+            break;
+        case Command::GetServoData:
+            // [joint, address] 이면 1바이트, [joint, address, mode(1)] 이면 2바이트 값
+            if (packet.size >= 3 && packet.At(2) == 1)
+            {
+                Reply(ServoData16Reply::Encode(ServoLoad), now);
+            }
+            else
+            {
+                Reply(ServoData8Reply::Encode(ServoLoad), now);
+            }
+            break;
+        case Command::GetSpeed:
+            Reply(FlagReply<Command::GetSpeed>::Encode(speed_percent), now);
+            break;
+
+        // --- 동작 명령 (응답 없음) ---
+        case Command::WriteAngles:
+            if (packet.size >= 13)
+            {
+                for (std::size_t i = 0; i < 6; ++i)
+                {
+                    target_angles[i] = packet.Int16(i * 2) / 100.0;
+                }
+                joint_speed = config.max_joint_speed * packet.At(12) / 100.0;
+            }
+            break;
+        case Command::WriteAngle:
+            if (packet.size >= 4 && packet.At(0) >= 1 && packet.At(0) <= 6)
+            {
+                target_angles[packet.At(0) - 1u] = packet.Int16(1) / 100.0;
+                joint_speed = config.max_joint_speed * packet.At(3) / 100.0;
+            }
+            break;
+        case Command::WriteCoords:
+            if (packet.size >= 13)
+            {
+                for (std::size_t i = 0; i < 6; ++i)
+                {
+                    target_coords[i] = packet.Int16(i * 2) / (i < 3 ? 10.0 : 100.0);
+                }
+                linear_speed = config.max_linear_speed * packet.At(12) / 100.0;
+            }
+            break;
+        case Command::WriteCoord:
+            if (packet.size >= 4 && packet.At(0) >= 1 && packet.At(0) <= 6)
+            {
+                target_coords[packet.At(0) - 1u] = packet.Int16(1) / 10.0;
+                linear_speed = config.max_linear_speed * packet.At(3) / 100.0;
+            }
+            break;
+        case Command::SetEncoders:
+            if (packet.size >= 13)
+            {
+                for (std::size_t i = 0; i < 6; ++i)
+                {
+                    target_angles[i] = (packet.Int16(i * 2) - EncoderCenter) / EncoderPerDegree;
+                }
+                joint_speed = config.max_joint_speed * packet.At(12) / 100.0;
+            }
+            break;
+        case Command::SetEncoder:
+            if (packet.size >= 3 && packet.At(0) >= 1 && packet.At(0) <= 6)
+            {
+                target_angles[packet.At(0) - 1u] = (packet.Int16(1) - EncoderCenter) / EncoderPerDegree;
+            }
+            break;
+        case Command::SetSpeed:
+            if (packet.size >= 1)
+            {
+                speed_percent = std::clamp(static_cast<int>(packet.At(0)), 0, 100);
+            }
+            break;
+        case Command::TaskStop:
+            target_angles = angles;
+            target_coords = coords;
+            break;
+        case Command::ProgramPause:
+            paused = true;
+            break;
+        case Command::ProgramResume:
+            paused = false;
+            break;
+        case Command::PowerOn:
+            powered_on = true;
+            servos_enabled = true;
+            break;
+        case Command::PowerOff:
+            powered_on = false;
+            break;
+        case Command::ReleaseAllServos:
+            servos_enabled = false;
+            break;
+        case Command::SetFreshMode:
+            if (packet.size >= 1)
+            {
+                fresh_mode = packet.At(0);
+            }
+            break;
+        case Command::GripperMode:
+            break;
+        default:
+            ++stats.unknown_commands;
+            break;
+        }
+#pragma GCC diagnostic pop
+    }
+
+    void VirtualMyCobot::Step(Clock::time_point now)
+    {
+        const double dt = std::chrono::duration<double>(now - last_step).count();
+        if (dt <= 0.0)
+        {
+            return;
+        }
+        last_step = now;
+
+        std::lock_guard<std::mutex> lock(state_mutex);
+        const bool can_move = powered_on && servos_enabled && !paused;
+        for (std::size_t i = 0; i < 6; ++i)
+        {
+            const double previous = angles[i];
+            if (can_move)
+            {
+                angles[i] = MoveToward(angles[i], target_angles[i], joint_speed * dt);
+                coords[i] = MoveToward(coords[i], target_coords[i], linear_speed * dt);
+            }
+            joint_velocity[i] = (angles[i] - previous) / dt;
+        }
+    }
+
+    void VirtualMyCobot::FlushOutput(Clock::time_point now)
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        while (!outgoing.empty() && outgoing.front().due <= now)
+        {
+            const std::vector<char> &bytes = outgoing.front().bytes;
+            if (write(master_fd, bytes.data(), bytes.size()) < 0 && errno == EAGAIN)
+            {
+                // 클라이언트가 읽지 않아 PTY 버퍼가 찼습니다. 다음 wakeup에서 다시 시도합니다.
+                break;
+            }
+            ++stats.frames_sent;
+            stats.bytes_sent += bytes.size();
+            outgoing.pop_front();
+        }
+    }
+
+}
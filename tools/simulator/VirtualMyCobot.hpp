@@ -0,0 +1,131 @@
+#ifndef ROBOSIGNAL_VIRTUALMYCOBOT_HPP
+#define ROBOSIGNAL_VIRTUALMYCOBOT_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "PacketDecoder.hpp"
+
+namespace rc
+{
+
+    /// 가상 로봇 설정. Start() 전에만 바꿀 수 있습니다.
+    struct SimulatorConfig
+    {
+        // 포트 이름으로 쓸 심볼릭 링크 (예: "/tmp/ttyJETCOBOT"). 비어 있으면 만들지 않습니다.
+        std::string link_path{};
+        // 명령을 받은 뒤 응답을 보내기까지의 지연
+        std::chrono::microseconds response_latency{std::chrono::microseconds{500}};
+        // 송신 바이트를 이 속도(8N1, 바이트당 10비트)로 내보냅니다. 0이면 제한 없음
+        int baud_rate{1000000};
+        // 관절 움직임을 계산하는 주기
+        std::chrono::microseconds tick{std::chrono::microseconds{2000}};
+        // 속도 100%일 때의 관절 속도(deg/s)와 직교 속도(mm/s, 회전축은 deg/s)
+        double max_joint_speed{160.0};
+        double max_linear_speed{200.0};
+    };
+
+    /// 시뮬레이터 누적 통계
+    struct SimulatorStats
+    {
+        uint64_t frames_received{0};
+        uint64_t frames_sent{0};
+        uint64_t bytes_received{0};
+        uint64_t bytes_sent{0};
+        uint64_t unknown_commands{0};
+    };
+
+    /**
+     * @brief 의사 터미널(PTY)에서 Firmata 프레임으로 응답하는 가상 myCobot.
+     *
+     * Start()는 PTY를 만들고 별도 스레드에서 명령을 처리합니다. SlavePath()나
+     * SimulatorConfig::link_path를 MyCobot의 포트 이름으로 쓰면 실제 로봇 대신 연결됩니다.
+     * 관절은 명령된 속도로 목표를 향해 움직이며, 직교 좌표는 관절과 독립적으로
+     * 같은 방식으로 움직입니다 (기구학은 계산하지 않습니다).
+     */
+    class VirtualMyCobot
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit VirtualMyCobot(SimulatorConfig config = SimulatorConfig{});
+        ~VirtualMyCobot();
+
+        VirtualMyCobot(const VirtualMyCobot &) = delete;
+        VirtualMyCobot &operator=(const VirtualMyCobot &) = delete;
+
+        /// PTY를 열고 처리 스레드를 시작합니다. 실패하면 std::system_error를 던집니다.
+        void Start();
+        void Stop();
+        bool IsRunning() const { return running.load(std::memory_order_acquire); }
+
+        /// 클라이언트가 열어야 할 PTY 경로 (예: "/dev/pts/3")
+        const std::string &SlavePath() const { return slave_path; }
+        /// link_path가 있으면 link_path, 없으면 SlavePath()
+        std::string PortName() const;
+
+        SimulatorStats Stats() const;
+        std::array<double, 6> CurrentAngles() const;
+        std::array<double, 6> CurrentCoords() const;
+
+    private:
+        struct Outgoing
+        {
+            Clock::time_point due; // 마지막 바이트가 선로를 다 지나는 시각
+            std::vector<char> bytes;
+        };
+
+        void Run();
+        void ReadInput();
+        void HandleCommand(const PacketView &packet, Clock::time_point now);
+        void Step(Clock::time_point now);
+        void FlushOutput(Clock::time_point now);
+        Clock::time_point NextWakeup(Clock::time_point now) const;
+
+        template <std::size_t N>
+        void Reply(const std::array<char, N> &frame, Clock::time_point now)
+        {
+            Enqueue(frame.data(), N, now);
+        }
+        void Enqueue(const char *data, std::size_t size, Clock::time_point now);
+
+        SimulatorConfig config;
+        int master_fd{-1};
+        int slave_fd{-1}; // 클라이언트가 닫아도 master 읽기가 EIO가 되지 않도록 열어 둡니다.
+        std::string slave_path{};
+        std::thread thread{};
+        std::atomic<bool> running{false};
+        std::atomic<bool> stop_requested{false};
+
+        PacketDecoder decoder{};
+        std::deque<Outgoing> outgoing{};
+        Clock::time_point line_free_at{}; // 송신 선로가 비는 시각 (baud 제한)
+        Clock::time_point last_step{};
+
+        // --- 로봇 상태 (state_mutex로 보호) ---
+        mutable std::mutex state_mutex{};
+        std::array<double, 6> angles{};
+        std::array<double, 6> target_angles{};
+        std::array<double, 6> joint_velocity{}; // deg/s, 마지막 Step 기준
+        std::array<double, 6> coords{};
+        std::array<double, 6> target_coords{};
+        double joint_speed{0.0};  // deg/s
+        double linear_speed{0.0}; // mm/s
+        int speed_percent{50};
+        bool powered_on{true};
+        bool servos_enabled{true};
+        bool paused{false};
+        int fresh_mode{0};
+        SimulatorStats stats{};
+    };
+
+}
+#endif
@@ -0,0 +1,101 @@
+/**
+ * @file main.cpp
+ * @brief PTY 기반 가상 myCobot 실행 파일
+ *
+ * 사용법:
+ * ./mycobot_sim [--link PATH] [--latency-us N] [--baud N] [--tick-us N]
+ * 예시: ./mycobot_sim --link /tmp/ttyJETCOBOT --latency-us 800
+ *
+ * 출력된 포트 이름을 MyCobot의 포트 이름으로 사용하면 실제 로봇 없이 테스트할 수 있습니다.
+ */
+
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "VirtualMyCobot.hpp"
+
+namespace
+{
+  volatile std::sig_atomic_t g_stop = 0;
+
+  void HandleSignal(int)
+  {
+    g_stop = 1;
+  }
+
+  void PrintUsage(const char *program)
+  {
+    std::cerr << "사용법: " << program
+              << " [--link PATH] [--latency-us N] [--baud N] [--tick-us N]" << std::endl;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  rc::SimulatorConfig config;
+  config.link_path = "/tmp/ttyJETCOBOT";
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc)
+    {
+      PrintUsage(argv[0]);
+      return 1;
+    }
+    const std::string value = argv[++i];
+    if (arg == "--link")
+    {
+      config.link_path = value;
+    }
+    else if (arg == "--latency-us")
+    {
+      config.response_latency = std::chrono::microseconds{std::stol(value)};
+    }
+    else if (arg == "--baud")
+    {
+      config.baud_rate = std::stoi(value);
+    }
+    else if (arg == "--tick-us")
+    {
+      config.tick = std::chrono::microseconds{std::stol(value)};
+    }
+    else
+    {
+      PrintUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  std::signal(SIGINT, HandleSignal);
+  std::signal(SIGTERM, HandleSignal);
+
+  rc::VirtualMyCobot robot(config);
+  try
+  {
+    robot.Start();
+  }
+  catch (const std::exception &e)
+  {
+    std::cerr << "시뮬레이터 시작 실패: " << e.what() << std::endl;
+    return 1;
+  }
+
+  std::cout << "가상 myCobot 실행 중: " << robot.PortName() << " -> " << robot.SlavePath() << std::endl;
+  std::cout << "종료하려면 Ctrl+C를 누르세요." << std::endl;
+
+  while (!g_stop)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  robot.Stop();
+
+  const rc::SimulatorStats stats = robot.Stats();
+  std::cout << "수신 프레임: " << stats.frames_received
+            << ", 송신 프레임: " << stats.frames_sent
+            << ", 알 수 없는 명령: " << stats.unknown_commands << std::endl;
+  return 0;
+}